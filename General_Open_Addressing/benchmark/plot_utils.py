@@ -108,3 +108,69 @@ def plot_multiple_cumulative(run_data_list, title='Multiple Cumulative Time Comp
     plt.close()
     print(f"Combined cumulative plot saved to {out_file}")
 
+
+def plot_quality_heatmap(df, metric, title='Hash Quality', out_file='quality.png'):
+    """
+    Plots one quality metric as a hash function by key set heatmap.
+
+    Parameters
+    ----------
+    df : pandas.DataFrame
+        Rows of the quality CSV with 'Hash', 'KeySet' and the metric column.
+    metric : str
+        Column to plot, e.g. 'MaxCluster' or 'ChiSquaredZ'.
+    title : str, optional
+        Plot title.
+    out_file : str, optional
+        File path to save the plot.
+    """
+    table = df.pivot_table(index='Hash', columns='KeySet', values=metric, sort=False)
+
+    plt.figure(figsize=(10, 6))
+    sns.heatmap(table, annot=True, fmt='.3g', cmap='rocket_r')
+    plt.title(title, fontsize=14)
+    plt.xlabel("Key Set", fontsize=12)
+    plt.ylabel("Hash Function", fontsize=12)
+
+    os.makedirs(os.path.dirname(out_file), exist_ok=True)
+    plt.tight_layout()
+    plt.savefig(out_file, dpi=300)
+    plt.close()
+    print(f"Quality heatmap saved to {out_file}")
+
+
+def plot_probe_distribution(df, title='Probe Length Distribution', out_file='probes.png'):
+    """
+    Plots the share of keys placed at each probe length, one panel per key set
+    and one line per hash function.
+
+    Parameters
+    ----------
+    df : pandas.DataFrame
+        Rows of the probe histogram CSV with 'Hash', 'KeySet', 'ProbeLength'
+        and 'Count' columns.
+    title : str, optional
+        Plot title.
+    out_file : str, optional
+        File path to save the plot.
+    """
+    keysets = list(dict.fromkeys(df['KeySet']))
+    fig, axs = plt.subplots(1, len(keysets), figsize=(4 * len(keysets), 5), sharey=True, squeeze=False)
+
+    for ax, keyset in zip(axs[0], keysets):
+        for hashf, group in df[df['KeySet'] == keyset].groupby('Hash', sort=False):
+            share = group['Count'] / group['Count'].sum()
+            ax.plot(group['ProbeLength'], share, marker='.', label=hashf)
+        ax.set_title(keyset)
+        ax.set_xlabel("Probe Length")
+        ax.set_yscale('log')
+        ax.grid(True, linestyle='--', alpha=0.5)
+    axs[0][0].set_ylabel("Share of Keys")
+    axs[0][0].legend(fontsize=8)
+
+    fig.suptitle(title, fontsize=14)
+    os.makedirs(os.path.dirname(out_file), exist_ok=True)
+    plt.tight_layout()
+    plt.savefig(out_file, dpi=300)
+    plt.close()
+    print(f"Probe length distribution saved to {out_file}")
@@ -10,7 +10,13 @@ import subprocess
 import numpy as np
 import pandas as pd
 
-from plot_utils import plot_cumulative_time, plot_histogram_and_box, plot_multiple_cumulative
+from plot_utils import (plot_cumulative_time, plot_histogram_and_box, plot_multiple_cumulative,
+                        plot_quality_heatmap, plot_probe_distribution)
+
+# Columns of the quality CSV that depend on the probe sequence
+PROBE_METRICS = ['MeanProbe', 'P99Probe', 'MaxProbe', 'MaxCluster']
+# Columns that depend only on the hash and the keys
+HASH_METRICS = ['ChiSquaredZ', 'AvalancheBias']
 
 
 def run_benchmarks(config_path, exec_path, results_dir):
@@ -48,6 +54,8 @@ def run_benchmarks(config_path, exec_path, results_dir):
             '--load-factor', str(load_factor),
             '--output-file', out_csv_path
         ]
+        if 'growth' in bench:
+            cmd += ['--growth', str(bench['growth'])]
         print(f"\nRunning benchmark: {cmd}")
         subprocess.run(cmd, check=False)
 
@@ -60,6 +68,81 @@ def run_benchmarks(config_path, exec_path, results_dir):
     return generated_csvs
 
 
+def run_quality_benchmark(config_path, exec_path, results_dir):
+    """
+    Runs the hash quality benchmark over every hash, probe and key set.
+    Returns the (summary, probe histogram) CSV paths, or None if it failed.
+    """
+    with open(config_path, 'r') as f:
+        config = json.load(f)
+
+    quality = config.get('quality')
+    if quality is None:
+        return None
+
+    os.makedirs(results_dir, exist_ok=True)
+    load_factor = quality.get('load_factor', 0.75)
+    growth = quality.get('growth', 2.0)
+    out_csv_path = os.path.join(results_dir,
+                                f"quality_lf{load_factor:.2f}_g{growth:.2f}.csv")
+    hist_csv_path = out_csv_path.replace('.csv', '_probes.csv')
+
+    cmd = [
+        exec_path,
+        '--mode', 'quality',
+        '--num-tests', str(quality.get('num_keys', 100000)),
+        '--load-factor', str(load_factor),
+        '--growth', str(growth),
+        '--output-file', out_csv_path
+    ]
+    print(f"\nRunning quality benchmark: {cmd}")
+    subprocess.run(cmd, check=False)
+
+    if not os.path.exists(out_csv_path) or not os.path.exists(hist_csv_path):
+        print(f"Warning: quality CSVs not created for: {cmd}")
+        return None
+    return out_csv_path, hist_csv_path
+
+
+def report_quality(summary_csv, hist_csv, plots_dir):
+    """
+    Prints the worst hash/key set combinations and plots one heatmap per metric.
+    """
+    df = pd.read_csv(summary_csv)
+    hist = pd.read_csv(hist_csv)
+
+    # chi-squared z above 3 means home slots are far from uniform
+    skewed = df.drop_duplicates(['Hash', 'KeySet'])
+    skewed = skewed[skewed['ChiSquaredZ'].abs() > 3]
+    print("\nNon-uniform home slots (|chi-squared z| > 3):")
+    print(skewed[['Hash', 'KeySet', 'ChiSquaredZ', 'AvalancheBias']].to_string(index=False))
+
+    print("\nLongest clusters per probe:")
+    worst = df.loc[df.groupby('Probe')['MaxCluster'].idxmax()]
+    print(worst[['Probe', 'Hash', 'KeySet', 'MaxCluster', 'MeanProbe']].to_string(index=False))
+
+    # double_hash steps by the primary hash, double_hash2 by a secondary one
+    single = df[df['Probe'] == 'double_hash'].set_index(['Hash', 'KeySet'])
+    double = df[df['Probe'] == 'double_hash2'].set_index(['Hash', 'KeySet'])
+    if not single.empty and not double.empty:
+        steps = single[['MeanProbe', 'MaxProbe']].join(
+            double[['MeanProbe', 'MaxProbe']], rsuffix='2', how='inner')
+        print("\nDouble hashing, primary hash step vs secondary hash step:")
+        print(steps.to_string())
+
+    for metric in PROBE_METRICS:
+        for probe, group in df.groupby('Probe'):
+            out_file = os.path.join(plots_dir, f"quality_{metric}_{probe}.png")
+            plot_quality_heatmap(group, metric, title=f"{metric} - {probe}", out_file=out_file)
+    for metric in HASH_METRICS:
+        group = df.drop_duplicates(['Hash', 'KeySet'])
+        out_file = os.path.join(plots_dir, f"quality_{metric}.png")
+        plot_quality_heatmap(group, metric, title=metric, out_file=out_file)
+    for probe, group in hist.groupby('Probe'):
+        out_file = os.path.join(plots_dir, f"quality_probe_lengths_{probe}.png")
+        plot_probe_distribution(group, title=f"Probe Length Distribution - {probe}", out_file=out_file)
+
+
 def load_csv_data(csv_path):
     """
     Loads CSV data using Pandas. Assumes the CSV has at least two columns where
@@ -130,6 +213,11 @@ def main():
         combined_plot = os.path.join(plots_dir, "all_cumulative.png")
         plot_multiple_cumulative(run_data_list, title="All Benchmarks (Cumulative)", out_file=combined_plot)
 
+    # 4) Hash quality over the key distributions
+    quality_csvs = run_quality_benchmark(config_path, exec_path, results_dir)
+    if quality_csvs:
+        report_quality(*quality_csvs, plots_dir)
+
     print("\nAll benchmarks processed and plots generated.")
 
 
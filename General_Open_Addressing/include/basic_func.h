@@ -14,6 +14,20 @@ uint32_t sdbm_hash(void *key, size_t len);       // SDBM hashing algorithm
 uint32_t fnv1a_hash(void *key, size_t len);      // FNV-1a hashing algorithm
 uint32_t murmur3_32_hash(void *key, size_t len); // Murmur3 hashing algorithm
 uint32_t crc32_hash(void *key, size_t len);      // CRC32 hashing algorithm
+uint32_t crc32c_hash(void *key, size_t len);     // CRC32C, SSE4.2 when available
+uint32_t wyhash_32_hash(void *key, size_t len);  // wyhash folded to 32 bits
+uint64_t wyhash_64_hash(void *key, size_t len);  // wyhash, full 64-bit result
+uint32_t int32_hash(void *key, size_t len);      // 4-byte integer keys only
+uint32_t int64_hash(void *key, size_t len);      // 8-byte integer keys only
+
+/**
+ * Batch Hash Functions
+ *
+ * Hash n keys into out[], bit-identical to the scalar function of the same
+ * name. Runs of equal-length keys are hashed in parallel SIMD lanes.
+ */
+void hash_batch_murmur3_32(void **keys, const size_t *lens, size_t n, uint32_t *out);
+void hash_batch_fnv1a(void **keys, const size_t *lens, size_t n, uint32_t *out);
 
 /**
  * Probing Functions
@@ -21,8 +35,9 @@ uint32_t crc32_hash(void *key, size_t len);      // CRC32 hashing algorithm
  * These functions determine the probing strategy for open addressing in hash tables.
  */
 uint32_t linear_probe_func(uint32_t k, uint32_t i, uint32_t m);       // Linear probing
-uint32_t quadratic_probe_func(uint32_t k, uint32_t i, uint32_t m);    // Quadratic probing
+uint32_t quadratic_probe_func(uint32_t k, uint32_t i, uint32_t m);    // Quadratic (triangular) probing
 uint32_t double_hash_probe_func(uint32_t k, uint32_t i, uint32_t m);  // Double hashing
+uint32_t bucket_probe_func(uint32_t k, uint32_t i, uint32_t m);       // Cache line, then triangular/double hash jumps
 
 /**
  * Comparison Functions
@@ -22,6 +22,13 @@
 #define DEFAULT_SIZE_MAX 1048576
 /** Default minimum size of the hash table */
 #define DEFAULT_SIZE_MIN 13
+/** Default size multiplier when the table grows, 2 keeps power-of-2 sizes */
+#define DEFAULT_GROWTH_FACTOR 2.0f
+/** Largest capacity resize() will allocate */
+#define HT_SIZE_LIMIT 0x80000000u
+/** Extra growth steps tried when entries find no free slot on their probe
+ *  sequence, before an insert or resize gives up */
+#define HT_GROW_RETRIES 4
 
 /* --- Error Return Codes --------------------------------------------------- */
 
@@ -57,6 +64,11 @@ typedef struct htentry HTentry;
  * @param min_load_factor    Minimum load factor before downsizing.
  * @param inactive_factor    Threshold for inactive entries to trigger downsizing.
  * @param hash_func          Function pointer to the hash function.
+ * @param hash_func2         Optional secondary hash for double_hash_probe_func.
+ *                           Its result sets the probe step, so keys whose
+ *                           hash_func values collide still get different
+ *                           probe sequences. NULL derives the step from
+ *                           hash_func, ignored by the other probe methods.
  * @param cmp_func           Function pointer to the key comparison function.
  * @param p                  Function pointer to the probing method.
  * @return A pointer to the initialized hash table, or NULL on failure.
@@ -66,6 +78,7 @@ HashTab *init_ht(
         float min_load_factor,
         float inactive_factor,
         uint32_t (*hash_func)(void *key, size_t len),
+        uint32_t (*hash_func2)(void *key, size_t len),
         int (*cmp_func)(const void *key1, const void *key2),
         uint32_t (*p)(uint32_t k, uint32_t i, uint32_t m),
         void (*freekey)(void *k),
@@ -84,6 +97,9 @@ int free_ht(
 
 /**
  * @brief Search for a key in the hash table.
+ *
+ * A key found past a deleted slot is moved into the first such slot, so
+ * indices returned by earlier searches may no longer be valid.
  * 
  * @param self  Pointer to the hash table.
  * @param key   Key to search for.
@@ -124,6 +140,10 @@ int insert_ht(
 
 /**
  * @brief Remove a key from the hash table.
+ *
+ * With linear probing (linear_probe_func or the default probe) the entry
+ * is freed right away and its cluster shifted back, no tombstone is left.
+ * Other probe functions mark the slot deleted.
  * 
  * @param self  Pointer to the hash table.
  * @param key   Key to remove.
@@ -135,6 +155,24 @@ int remove_ht(
         size_t key_len
 );
 
+/**
+ * @brief Set the factor the table grows by, and shrinks by, on resize.
+ *
+ * The default of 2 keeps power-of-2 sizes. Any other factor, e.g. 1.25 or
+ * 1.5 to bound the memory overshoot of large tables, rounds sizes up to a
+ * prime and reduces premixed hashes with a multiply-shift instead of a
+ * mask. Custom probe functions must then handle any table size. Takes
+ * effect on the next resize.
+ *
+ * @param self           Pointer to the hash table.
+ * @param growth_factor  Size multiplier, greater than 1.
+ * @return HT_SUCCESS, or HT_INVALID_ARG for a NULL table or a factor <= 1.
+ */
+int set_growth_ht(
+        HashTab *self,
+        float growth_factor
+);
+
 /**
  * @brief Print the contents of the hash table.
  * 
@@ -0,0 +1,254 @@
+/**
+ * @file    probe_iter.h
+ * @brief   Stateful probe sequence iterators and slot reduction.
+ *
+ * A probe function p(k, i, m) recomputes slot i from scratch on every call.
+ * The iterators below keep the current slot and the distance to the next
+ * one instead, so each step is two adds and a wrap:
+ *
+ *   linear       h, h+1, h+2, ...           delta 1, grows by 0
+ *   triangular   h, h+1, h+3, h+6, ...      delta 1, grows by 1
+ *   double hash  h, h+s, h+2s, ...          delta s = probe_step(k2), grows by 0
+ *   bucket       every slot of h's cache line, then the same offset in the
+ *                next line, lines jump triangularly, or by a double hashing
+ *                step when m is not a power of 2
+ *
+ * where h = probe_home(k). A power-of-2 table wraps with a mask and takes
+ * h from the low bits of k. Any other size m premixes k, so weak hashes
+ * whose entropy sits in the low bits still spread, takes h from the high
+ * bits with Lemire's multiply-shift and wraps by subtracting m, so no step
+ * divides. Triangular probing reaches every slot only for powers of 2 and
+ * double hashing only when s and m are coprime, e.g. for prime m.
+ *
+ * Bucket probing needs m to be a multiple of HT_LINE_SLOTS and, for other
+ * than power-of-2 sizes, m / HT_LINE_SLOTS prime; any other m probes
+ * linearly.
+ *
+ * With k2 = k they visit the same slots, in the same order, as
+ * linear_probe_func, quadratic_probe_func, double_hash_probe_func and
+ * bucket_probe_func. A k2
+ * from an independent hash gives keys with equal k different double
+ * hashing sequences. Any other probe function is stepped through its
+ * pointer.
+ */
+
+#ifndef PROBE_ITER_H
+#define PROBE_ITER_H
+
+#include <stdint.h>
+
+/** Cache line size the table is aligned to */
+#define HT_CACHE_LINE 64
+/** sizeof(HTentry): a flag and two hash codes, padded to pointer
+ *  alignment, then the key and value pointers. open_addressing.c checks it
+ *  against the struct */
+#define HT_ENTRY_SIZE \
+    ((sizeof(int) + 2 * sizeof(uint32_t) + sizeof(void *) - 1) / \
+     sizeof(void *) * sizeof(void *) + 2 * sizeof(void *))
+/** Table slots per cache line, HT_CACHE_LINE / HT_ENTRY_SIZE rounded down
+ *  to a power of 2 */
+#define HT_LINE_SLOTS \
+    (HT_CACHE_LINE / HT_ENTRY_SIZE >= 4 ? 4 : \
+     HT_CACHE_LINE / HT_ENTRY_SIZE >= 2 ? 2 : 1)
+
+/* --- Data Structures ----------------------------------------------------- */
+
+/** Probe sequences with an inline iterator */
+typedef enum {
+    PROBE_CUSTOM = 0,    /* call the probe function for every step */
+    PROBE_LINEAR,
+    PROBE_TRIANGULAR,
+    PROBE_DOUBLE_HASH,
+    PROBE_BUCKET
+} ProbeKind;
+
+/** Position in the probe sequence of one hash key */
+typedef struct {
+    uint32_t index;      /* current slot                                */
+    uint32_t delta;      /* distance to the next slot                   */
+    uint32_t growth;     /* added to delta after each step              */
+    uint32_t mask;       /* table size - 1, or 0 when m is not a power of 2 */
+    uint32_t m;          /* table size                                  */
+    uint32_t i;          /* steps taken, PROBE_CUSTOM, or within the line */
+    uint32_t k;          /* hash key, only kept for PROBE_CUSTOM        */
+    uint32_t base;       /* first slot of the current line, PROBE_BUCKET */
+    uint32_t offset;     /* h's offset within its line, PROBE_BUCKET    */
+    uint32_t width;      /* slots scanned per line, 1 unless PROBE_BUCKET */
+    uint32_t (*p)(uint32_t k, uint32_t i, uint32_t m);
+} ProbeIter;
+
+/* --- Functions ----------------------------------------------------------- */
+
+/**
+ * @brief Lemire's multiply-shift range reduction, maps x onto [0, m) using
+ *        its high bits, without a division.
+ */
+static inline uint32_t ht_fastrange32(
+        uint32_t x,
+        uint32_t m
+) {
+    return (uint32_t)(((uint64_t)x * m) >> 32);
+}
+
+/**
+ * @brief Spreads the low bits of x into the high bits ht_fastrange32 reads:
+ *        a Fibonacci multiply, then the high half folded back down.
+ */
+static inline uint32_t ht_premix32(
+        uint32_t x
+) {
+    x *= 0x9E3779B1u;
+    return x ^ (x >> 16);
+}
+
+/**
+ * @brief Premixed key for probe steps, its halves swapped so the step does
+ *        not follow the home slot when k2 == k.
+ */
+static inline uint32_t ht_premix32_step(
+        uint32_t x
+) {
+    x = ht_premix32(x);
+    return (x << 16) | (x >> 16);
+}
+
+/**
+ * @brief Home slot of hash key k in a table of m slots.
+ */
+static inline uint32_t probe_home(
+        uint32_t k,
+        uint32_t m
+) {
+    return (m & (m - 1)) == 0 ? k & (m - 1) : ht_fastrange32(ht_premix32(k), m);
+}
+
+/**
+ * @brief Double hashing step for secondary hash key k2: odd for a power-of-2
+ *        m, else in [1, m - 1] so any prime m is fully covered.
+ */
+static inline uint32_t probe_step(
+        uint32_t k2,
+        uint32_t m
+) {
+    return (m & (m - 1)) == 0 ? (k2 << 1) | 1 :
+        1 + ht_fastrange32(ht_premix32_step(k2), m - 1);
+}
+
+/**
+ * @brief (a + b) mod m for a, b < m, without overflow or division.
+ */
+static inline uint32_t probe_wrap_add(
+        uint32_t a,
+        uint32_t b,
+        uint32_t m
+) {
+    return a >= m - b ? a - (m - b) : a + b;
+}
+
+/**
+ * @brief Whether bucket probing can run on a table of m slots, else it
+ *        falls back to linear probing.
+ */
+static inline int probe_bucket_fits(
+        uint32_t m
+) {
+    return m % HT_LINE_SLOTS == 0;
+}
+
+/**
+ * @brief Line jump of bucket probing for a table of m slots that is not a
+ *        power of 2, in lines: in [1, m / HT_LINE_SLOTS - 1], so every line
+ *        is reached when the line count is prime.
+ */
+static inline uint32_t probe_line_step(
+        uint32_t k2,
+        uint32_t m
+) {
+    uint32_t lines = m / HT_LINE_SLOTS;
+
+    return lines > 1 ? 1 + ht_fastrange32(ht_premix32_step(k2), lines - 1) : 0;
+}
+
+/**
+ * @brief Starts the probe sequence of hash key k in a table of m slots.
+ *
+ * @param it Iterator to initialise.
+ * @param kind Sequence to follow.
+ * @param p Probe function, only called when kind is PROBE_CUSTOM.
+ * @param k Hash key.
+ * @param k2 Secondary hash key setting the double hashing step, else unused.
+ * @param m Table size, at least 2.
+ *
+ * @return The first slot of the sequence.
+ */
+static inline uint32_t probe_iter_init(
+        ProbeIter *it,
+        ProbeKind kind,
+        uint32_t (*p)(uint32_t k, uint32_t i, uint32_t m),
+        uint32_t k,
+        uint32_t k2,
+        uint32_t m
+) {
+    it->m = m;
+    it->mask = (m & (m - 1)) == 0 ? m - 1 : 0;
+    it->delta = kind == PROBE_DOUBLE_HASH ? probe_step(k2, m) : 1;
+    it->growth = kind == PROBE_TRIANGULAR ? 1 : 0;
+    it->i = 0;
+    it->k = k;
+    it->width = 1;
+    if (kind == PROBE_CUSTOM) {
+        it->p = p;
+        it->index = p(k, 0, m);
+        return it->index;
+    }
+    it->p = NULL;
+    it->index = probe_home(k, m);
+    if (kind == PROBE_BUCKET && probe_bucket_fits(m)) {
+        it->width = HT_LINE_SLOTS;
+        it->offset = it->index & (HT_LINE_SLOTS - 1);
+        it->base = it->index - it->offset;
+        /* delta and growth count slots, whole lines at a time */
+        it->delta = it->mask ? HT_LINE_SLOTS : HT_LINE_SLOTS * probe_line_step(k2, m);
+        it->growth = it->mask ? HT_LINE_SLOTS : 0;
+    }
+    return it->index;
+}
+
+/**
+ * @brief Advances to the next slot of the sequence.
+ *
+ * @return The new current slot.
+ */
+static inline uint32_t probe_iter_next(
+        ProbeIter *it
+) {
+    if (it->p) {
+        it->index = it->p(it->k, ++it->i, it->m);
+        return it->index;
+    }
+    if (it->width > 1) {
+        if (++it->i < it->width) {
+            it->index = it->base + ((it->offset + it->i) & (it->width - 1));
+            return it->index;
+        }
+        it->i = 0;
+        if (it->mask) {
+            it->base = (it->base + it->delta) & it->mask;
+            it->delta += it->growth;
+        } else {
+            it->base = probe_wrap_add(it->base, it->delta, it->m);
+        }
+        it->index = it->base + it->offset;
+        return it->index;
+    }
+    if (it->mask) {
+        it->index = (it->index + it->delta) & it->mask;
+        it->delta += it->growth;
+    } else {
+        it->index = probe_wrap_add(it->index, it->delta, it->m);
+        it->delta = probe_wrap_add(it->delta, it->growth, it->m);
+    }
+    return it->index;
+}
+
+#endif /* PROBE_ITER_H */
@@ -0,0 +1,287 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <basic_func.h>
+#include <cpu_dispatch.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define HAVE_X86_BATCH
+#endif
+
+/**
+ * Batch Hash Functions
+ *
+ * Hash n keys into out[], bit-identical to the scalar murmur3_32_hash and
+ * fnv1a_hash. Runs of equal-length keys are hashed in parallel SIMD lanes,
+ * 16 with AVX-512 and 8 with AVX2; any other key goes through the scalar
+ * function. The kernel is picked once before main() runs, see cpu_dispatch.h.
+ */
+
+#define MURMUR_C1   0xcc9e2d51u
+#define MURMUR_C2   0x1b873593u
+#define MURMUR_N    0xe6546b64u
+#define MURMUR_FMIX1 0x85ebca6bu
+#define MURMUR_FMIX2 0xc2b2ae35u
+#define FNV_OFFSET  2166136261u
+#define FNV_PRIME   16777619u
+
+/** Hashes one group of equal-length keys, one key per lane */
+typedef void (*lane_kernel_t)(void **keys, size_t len, uint32_t *out);
+
+static void hash_batch(void **keys, const size_t *lens, size_t n, uint32_t *out,
+        size_t lanes, lane_kernel_t kernel, uint32_t (*scalar)(void *, size_t));
+static inline uint32_t load_le(const unsigned char *p, size_t n);
+
+#ifdef HAVE_X86_BATCH
+static void murmur3_lanes_avx2(void **keys, size_t len, uint32_t *out);
+static void fnv1a_lanes_avx2(void **keys, size_t len, uint32_t *out);
+static void murmur3_lanes_avx512(void **keys, size_t len, uint32_t *out);
+static void fnv1a_lanes_avx512(void **keys, size_t len, uint32_t *out);
+#endif
+
+/* 0 lanes selects the scalar path for every key */
+static size_t batch_lanes = 0;
+static lane_kernel_t murmur3_lanes = NULL;
+static lane_kernel_t fnv1a_lanes = NULL;
+
+/**
+ * @brief Pick the widest lane kernels the CPU supports.
+ */
+__attribute__((constructor))
+static void init_batch_kernels(void) {
+#ifdef HAVE_X86_BATCH
+    HTIsaLevel isa = ht_cpu_isa();
+
+    if (isa >= HT_ISA_AVX512) {
+        batch_lanes = 16;
+        murmur3_lanes = murmur3_lanes_avx512;
+        fnv1a_lanes = fnv1a_lanes_avx512;
+    } else if (isa >= HT_ISA_AVX2) {
+        batch_lanes = 8;
+        murmur3_lanes = murmur3_lanes_avx2;
+        fnv1a_lanes = fnv1a_lanes_avx2;
+    }
+#endif
+}
+
+void hash_batch_murmur3_32(void **keys, const size_t *lens, size_t n, uint32_t *out) {
+    hash_batch(keys, lens, n, out, batch_lanes, murmur3_lanes, murmur3_32_hash);
+}
+
+void hash_batch_fnv1a(void **keys, const size_t *lens, size_t n, uint32_t *out) {
+    hash_batch(keys, lens, n, out, batch_lanes, fnv1a_lanes, fnv1a_hash);
+}
+
+/**
+ * @brief Walk the batch, handing full groups of equal-length keys to the
+ *        lane kernel and everything else to the scalar hash.
+ */
+static void hash_batch(
+        void **keys,
+        const size_t *lens,
+        size_t n,
+        uint32_t *out,
+        size_t lanes,
+        lane_kernel_t kernel,
+        uint32_t (*scalar)(void *, size_t)
+) {
+    size_t i = 0, l;
+
+    while (i < n) {
+        if (kernel && i + lanes <= n) {
+            for (l = 1; l < lanes && lens[i + l] == lens[i]; l++);
+            if (l == lanes) {
+                kernel(keys + i, lens[i], out + i);
+                i += lanes;
+                continue;
+            }
+        }
+        out[i] = scalar(keys[i], lens[i]);
+        i++;
+    }
+}
+
+/**
+ * @brief Little-endian load of n (1 to 4) bytes, as murmur3 assembles words.
+ */
+static inline uint32_t load_le(const unsigned char *p, size_t n) {
+    uint32_t w = 0;
+
+    while (n--) {
+        w |= (uint32_t)p[n] << (8 * n);
+    }
+    return w;
+}
+
+#ifdef HAVE_X86_BATCH
+
+/* --- AVX2, 8 lanes ------------------------------------------------------- */
+
+#define ROTL_256(x, r) \
+    _mm256_or_si256(_mm256_slli_epi32((x), (r)), _mm256_srli_epi32((x), 32 - (r)))
+
+/**
+ * @brief Load the 4-byte word at offset off from each of 8 keys with two
+ *        64-bit-address gathers.
+ */
+__attribute__((target("avx2")))
+static inline __m256i gather_words_avx2(void **keys, size_t off) {
+    __m256i step = _mm256_set1_epi64x((long long)off);
+    __m256i lo = _mm256_add_epi64(_mm256_loadu_si256((const __m256i *)keys), step);
+    __m256i hi = _mm256_add_epi64(_mm256_loadu_si256((const __m256i *)(keys + 4)), step);
+
+    return _mm256_setr_m128i(
+        _mm256_i64gather_epi32((const int *)0, lo, 1),
+        _mm256_i64gather_epi32((const int *)0, hi, 1)
+    );
+}
+
+/**
+ * @brief Load the last n (1 to 3) bytes at offset off from each of 8 keys,
+ *        byte by byte so no lane reads past its key.
+ */
+__attribute__((target("avx2")))
+static inline __m256i tail_words_avx2(void **keys, size_t off, size_t n) {
+    uint32_t w[8];
+
+    for (int l = 0; l < 8; l++) {
+        w[l] = load_le((const unsigned char *)keys[l] + off, n);
+    }
+    return _mm256_loadu_si256((const __m256i *)w);
+}
+
+__attribute__((target("avx2")))
+static void murmur3_lanes_avx2(void **keys, size_t len, uint32_t *out) {
+    const __m256i c1 = _mm256_set1_epi32((int)MURMUR_C1);
+    const __m256i c2 = _mm256_set1_epi32((int)MURMUR_C2);
+    size_t rounded_end = len & ~(size_t)3;
+    __m256i h = _mm256_setzero_si256();
+    __m256i k;
+
+    for (size_t off = 0; off < rounded_end; off += 4) {
+        k = _mm256_mullo_epi32(gather_words_avx2(keys, off), c1);
+        k = _mm256_mullo_epi32(ROTL_256(k, 15), c2);
+        h = ROTL_256(_mm256_xor_si256(h, k), 13);
+        h = _mm256_add_epi32(
+            _mm256_add_epi32(_mm256_slli_epi32(h, 2), h),
+            _mm256_set1_epi32((int)MURMUR_N)
+        );
+    }
+    if (len & 3) {
+        k = _mm256_mullo_epi32(tail_words_avx2(keys, rounded_end, len & 3), c1);
+        k = _mm256_mullo_epi32(ROTL_256(k, 15), c2);
+        h = _mm256_xor_si256(h, k);
+    }
+
+    h = _mm256_xor_si256(h, _mm256_set1_epi32((int)(uint32_t)len));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32((int)MURMUR_FMIX1));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32((int)MURMUR_FMIX2));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+    _mm256_storeu_si256((__m256i *)out, h);
+}
+
+__attribute__((target("avx2")))
+static void fnv1a_lanes_avx2(void **keys, size_t len, uint32_t *out) {
+    const __m256i prime = _mm256_set1_epi32((int)FNV_PRIME);
+    const __m256i low_byte = _mm256_set1_epi32(0xFF);
+    __m256i h = _mm256_set1_epi32((int)FNV_OFFSET);
+    __m256i w;
+    size_t off, b, n;
+
+    for (off = 0; off < len; off += 4) {
+        n = len - off < 4 ? len - off : 4;
+        w = n == 4 ? gather_words_avx2(keys, off) : tail_words_avx2(keys, off, n);
+        for (b = 0; b < n; b++) {
+            h = _mm256_xor_si256(h, _mm256_and_si256(w, low_byte));
+            h = _mm256_mullo_epi32(h, prime);
+            w = _mm256_srli_epi32(w, 8);
+        }
+    }
+    _mm256_storeu_si256((__m256i *)out, h);
+}
+
+/* --- AVX-512, 16 lanes --------------------------------------------------- */
+
+/**
+ * @brief Load the 4-byte word at offset off from each of 16 keys.
+ */
+__attribute__((target("avx512f")))
+static inline __m512i gather_words_avx512(void **keys, size_t off) {
+    __m512i step = _mm512_set1_epi64((long long)off);
+    __m512i lo = _mm512_add_epi64(_mm512_loadu_si512((const void *)keys), step);
+    __m512i hi = _mm512_add_epi64(_mm512_loadu_si512((const void *)(keys + 8)), step);
+
+    return _mm512_inserti64x4(
+        _mm512_castsi256_si512(_mm512_i64gather_epi32(lo, (const void *)0, 1)),
+        _mm512_i64gather_epi32(hi, (const void *)0, 1),
+        1
+    );
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i tail_words_avx512(void **keys, size_t off, size_t n) {
+    uint32_t w[16];
+
+    for (int l = 0; l < 16; l++) {
+        w[l] = load_le((const unsigned char *)keys[l] + off, n);
+    }
+    return _mm512_loadu_si512((const void *)w);
+}
+
+__attribute__((target("avx512f")))
+static void murmur3_lanes_avx512(void **keys, size_t len, uint32_t *out) {
+    const __m512i c1 = _mm512_set1_epi32((int)MURMUR_C1);
+    const __m512i c2 = _mm512_set1_epi32((int)MURMUR_C2);
+    size_t rounded_end = len & ~(size_t)3;
+    __m512i h = _mm512_setzero_si512();
+    __m512i k;
+
+    for (size_t off = 0; off < rounded_end; off += 4) {
+        k = _mm512_mullo_epi32(gather_words_avx512(keys, off), c1);
+        k = _mm512_mullo_epi32(_mm512_rol_epi32(k, 15), c2);
+        h = _mm512_rol_epi32(_mm512_xor_si512(h, k), 13);
+        h = _mm512_add_epi32(
+            _mm512_add_epi32(_mm512_slli_epi32(h, 2), h),
+            _mm512_set1_epi32((int)MURMUR_N)
+        );
+    }
+    if (len & 3) {
+        k = _mm512_mullo_epi32(tail_words_avx512(keys, rounded_end, len & 3), c1);
+        k = _mm512_mullo_epi32(_mm512_rol_epi32(k, 15), c2);
+        h = _mm512_xor_si512(h, k);
+    }
+
+    h = _mm512_xor_si512(h, _mm512_set1_epi32((int)(uint32_t)len));
+    h = _mm512_xor_si512(h, _mm512_srli_epi32(h, 16));
+    h = _mm512_mullo_epi32(h, _mm512_set1_epi32((int)MURMUR_FMIX1));
+    h = _mm512_xor_si512(h, _mm512_srli_epi32(h, 13));
+    h = _mm512_mullo_epi32(h, _mm512_set1_epi32((int)MURMUR_FMIX2));
+    h = _mm512_xor_si512(h, _mm512_srli_epi32(h, 16));
+    _mm512_storeu_si512((void *)out, h);
+}
+
+__attribute__((target("avx512f")))
+static void fnv1a_lanes_avx512(void **keys, size_t len, uint32_t *out) {
+    const __m512i prime = _mm512_set1_epi32((int)FNV_PRIME);
+    const __m512i low_byte = _mm512_set1_epi32(0xFF);
+    __m512i h = _mm512_set1_epi32((int)FNV_OFFSET);
+    __m512i w;
+    size_t off, b, n;
+
+    for (off = 0; off < len; off += 4) {
+        n = len - off < 4 ? len - off : 4;
+        w = n == 4 ? gather_words_avx512(keys, off) : tail_words_avx512(keys, off, n);
+        for (b = 0; b < n; b++) {
+            h = _mm512_xor_si512(h, _mm512_and_si512(w, low_byte));
+            h = _mm512_mullo_epi32(h, prime);
+            w = _mm512_srli_epi32(w, 8);
+        }
+    }
+    _mm512_storeu_si512((void *)out, h);
+}
+
+#endif /* HAVE_X86_BATCH */
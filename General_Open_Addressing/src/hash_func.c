@@ -3,6 +3,64 @@
 #include <stddef.h>
 #include <string.h>
 #include <basic_func.h>
+#include <cpu_dispatch.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <nmmintrin.h>
+#define HAVE_SSE42_CRC32C
+#endif
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 wy_u128;
+#define HAVE_U128
+#endif
+
+/* --- CRC tables ---------------------------------------------------------- */
+
+/** Reflected CRC-32 (IEEE 802.3) polynomial */
+#define CRC32_POLY  0xEDB88320u
+/** Reflected CRC-32C (Castagnoli) polynomial */
+#define CRC32C_POLY 0x82F63B78u
+
+static uint32_t crc32_table[256];
+static uint32_t crc32c_table[8][256];
+
+static uint32_t crc32c_sw(uint32_t crc, const unsigned char *data, size_t len);
+#ifdef HAVE_SSE42_CRC32C
+static uint32_t crc32c_sse42(uint32_t crc, const unsigned char *data, size_t len);
+#endif
+
+/** CRC32C kernel picked once by init_crc_tables() */
+static uint32_t (*crc32c_impl)(uint32_t, const unsigned char *, size_t) = crc32c_sw;
+
+/**
+ * @brief Build the CRC tables and pick the CRC32C kernel before main() runs,
+ *        so the hash functions never initialise shared state lazily.
+ */
+__attribute__((constructor))
+static void init_crc_tables(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i, cc = i;
+        for (int j = 0; j < 8; j++) {
+            c = (c & 1) ? CRC32_POLY ^ (c >> 1) : c >> 1;
+            cc = (cc & 1) ? CRC32C_POLY ^ (cc >> 1) : cc >> 1;
+        }
+        crc32_table[i] = c;
+        crc32c_table[0][i] = cc;
+    }
+    /* table k advances a byte through k further zero bytes */
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int k = 1; k < 8; k++) {
+            uint32_t c = crc32c_table[k - 1][i];
+            crc32c_table[k][i] = (c >> 8) ^ crc32c_table[0][c & 0xFF];
+        }
+    }
+#ifdef HAVE_SSE42_CRC32C
+    if (ht_cpu_isa() >= HT_ISA_SSE42) {
+        crc32c_impl = crc32c_sse42;
+    }
+#endif
+}
 
 /**
  * djb2 Hash Function
@@ -62,7 +120,8 @@ uint32_t murmur3_32_hash(void *key, size_t len) {
 
     // Body
     for (size_t i = 0; i < rounded_end; i += 4) {
-        uint32_t k = data[i] | (data[i+1] << 8) | (data[i+2] << 16) | (data[i+3] << 24);
+        uint32_t k = (uint32_t)data[i] | ((uint32_t)data[i+1] << 8) |
+                     ((uint32_t)data[i+2] << 16) | ((uint32_t)data[i+3] << 24);
         k *= c1;
         k = (k << 15) | (k >> (32 - 15));
         k *= c2;
@@ -76,9 +135,9 @@ uint32_t murmur3_32_hash(void *key, size_t len) {
     uint32_t k1 = 0;
     switch (len & 0x3) {
         case 3:
-            k1 ^= data[rounded_end + 2] << 16;
+            k1 ^= (uint32_t)data[rounded_end + 2] << 16;
         case 2:
-            k1 ^= data[rounded_end + 1] << 8;
+            k1 ^= (uint32_t)data[rounded_end + 1] << 8;
         case 1:
             k1 ^= data[rounded_end];
             k1 *= c1;
@@ -98,6 +157,37 @@ uint32_t murmur3_32_hash(void *key, size_t len) {
     return hash;
 }
 
+/**
+ * 32-bit Integer Hash Function
+ *
+ * For 4-byte keys: Fibonacci multiply, then fold the high half down into
+ * the low bits used for indexing. Bijective, len is ignored.
+ */
+uint32_t int32_hash(void *key, size_t len) {
+    uint32_t k;
+
+    (void)len;
+    memcpy(&k, key, sizeof(k));
+    k *= 0x9E3779B1u;
+    return k ^ (k >> 16);
+}
+
+/**
+ * 64-bit Integer Hash Function
+ *
+ * For 8-byte keys: splitmix64 finalizer folded to 32 bits, len is ignored.
+ */
+uint32_t int64_hash(void *key, size_t len) {
+    uint64_t k;
+
+    (void)len;
+    memcpy(&k, key, sizeof(k));
+    k = (k ^ (k >> 30)) * 0xBF58476D1CE4E5B9ull;
+    k = (k ^ (k >> 27)) * 0x94D049BB133111EBull;
+    k ^= k >> 31;
+    return (uint32_t)(k ^ (k >> 32));
+}
+
 /**
  * CRC32 Hash Function
  *
@@ -106,26 +196,172 @@ uint32_t murmur3_32_hash(void *key, size_t len) {
 uint32_t crc32_hash(void *key, size_t len) {
     unsigned char *data = (unsigned char *)key;
     uint32_t crc = 0xFFFFFFFF;
-    static uint32_t table[256];
-    static int have_table = 0;
-
-    if (!have_table) {
-        for (uint32_t i = 0; i < 256; i++) {
-            uint32_t c = i;
-            for (int j = 0; j < 8; j++) {
-                if (c & 1)
-                    c = 0xEDB88320 ^ (c >> 1);
-                else
-                    c = c >> 1;
-            }
-            table[i] = c;
-        }
-        have_table = 1;
-    }
 
     for (size_t i = 0; i < len; i++) {
-        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        crc = crc32_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
     }
 
     return crc ^ 0xFFFFFFFF;
 }
+
+/**
+ * CRC32C Hash Function
+ *
+ * CRC-32C (Castagnoli), using the SSE4.2 crc32 instruction on 8-byte chunks
+ * when the CPU has it and slicing-by-8 tables otherwise.
+ */
+uint32_t crc32c_hash(void *key, size_t len) {
+    return crc32c_impl(0xFFFFFFFF, (const unsigned char *)key, len) ^ 0xFFFFFFFF;
+}
+
+/**
+ * @brief Slicing-by-8 CRC32C, folds eight input bytes per table round.
+ */
+static uint32_t crc32c_sw(uint32_t crc, const unsigned char *data, size_t len) {
+    while (len >= 8) {
+        uint32_t lo = crc ^ ((uint32_t)data[0] | (uint32_t)data[1] << 8 |
+                             (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24);
+        uint32_t hi = (uint32_t)data[4] | (uint32_t)data[5] << 8 |
+                      (uint32_t)data[6] << 16 | (uint32_t)data[7] << 24;
+        crc = crc32c_table[7][lo & 0xFF] ^
+              crc32c_table[6][(lo >> 8) & 0xFF] ^
+              crc32c_table[5][(lo >> 16) & 0xFF] ^
+              crc32c_table[4][lo >> 24] ^
+              crc32c_table[3][hi & 0xFF] ^
+              crc32c_table[2][(hi >> 8) & 0xFF] ^
+              crc32c_table[1][(hi >> 16) & 0xFF] ^
+              crc32c_table[0][hi >> 24];
+        data += 8;
+        len -= 8;
+    }
+    while (len--) {
+        crc = crc32c_table[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#ifdef HAVE_SSE42_CRC32C
+/**
+ * @brief SSE4.2 CRC32C, one crc32 instruction per 8-byte chunk.
+ */
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, const unsigned char *data, size_t len) {
+    uint64_t crc64 = crc;
+    uint64_t chunk;
+
+    while (len >= 8) {
+        memcpy(&chunk, data, sizeof(chunk));
+        crc64 = _mm_crc32_u64(crc64, chunk);
+        data += 8;
+        len -= 8;
+    }
+    crc = (uint32_t)crc64;
+    while (len--) {
+        crc = _mm_crc32_u8(crc, *data++);
+    }
+    return crc;
+}
+#endif
+
+/* --- wyhash -------------------------------------------------------------- */
+
+/** wyhash default secret, odd 64-bit constants with balanced bit counts */
+static const uint64_t wy_secret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+/**
+ * @brief 64x64 -> 128-bit multiply, low half in *a and high half in *b.
+ */
+static inline void wy_mum(uint64_t *a, uint64_t *b) {
+#ifdef HAVE_U128
+    wy_u128 r = (wy_u128)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline uint64_t wy_mix(uint64_t a, uint64_t b) {
+    wy_mum(&a, &b);
+    return a ^ b;
+}
+
+/* little-endian loads, compiled to single moves on x86 */
+static inline uint64_t wy_r8(const unsigned char *p) {
+    return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 |
+           (uint64_t)p[3] << 24 | (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 |
+           (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+static inline uint64_t wy_r4(const unsigned char *p) {
+    return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 |
+           (uint64_t)p[3] << 24;
+}
+
+/**
+ * wyhash (64-bit) Function
+ *
+ * Wang Yi's wyhash: folds 16 bytes per 128-bit multiply, with three
+ * independent lanes over 48-byte stripes for long keys.
+ */
+uint64_t wyhash_64_hash(void *key, size_t len) {
+    const unsigned char *p = (const unsigned char *)key;
+    uint64_t seed = wy_mix(wy_secret[0], wy_secret[1]);
+    uint64_t a, b;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (wy_r4(p) << 32) | wy_r4(p + ((len >> 3) << 2));
+            b = (wy_r4(p + len - 4) << 32) | wy_r4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = wy_mix(wy_r8(p) ^ wy_secret[1], wy_r8(p + 8) ^ seed);
+                see1 = wy_mix(wy_r8(p + 16) ^ wy_secret[2], wy_r8(p + 24) ^ see1);
+                see2 = wy_mix(wy_r8(p + 32) ^ wy_secret[3], wy_r8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = wy_mix(wy_r8(p) ^ wy_secret[1], wy_r8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        /* last 16 bytes, may overlap bytes already consumed */
+        a = wy_r8(p + i - 16);
+        b = wy_r8(p + i - 8);
+    }
+    a ^= wy_secret[1];
+    b ^= seed;
+    wy_mum(&a, &b);
+    return wy_mix(a ^ wy_secret[0] ^ len, b ^ wy_secret[1]);
+}
+
+/**
+ * wyhash (32-bit) Function
+ *
+ * wyhash_64_hash folded to 32 bits for the table's hash signature.
+ */
+uint32_t wyhash_32_hash(void *key, size_t len) {
+    uint64_t hash = wyhash_64_hash(key, len);
+    return (uint32_t)(hash ^ (hash >> 32));
+}
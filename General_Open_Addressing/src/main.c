@@ -68,6 +68,7 @@ int main(void)
      *   float min_load_factor    -> pass 0.0 to use default
      *   float inactive_factor    -> pass 0.0 to use default
      *   uint32_t (*hash_func)(void*, size_t) -> NULL for default
+     *   uint32_t (*hash_func2)(void*, size_t) -> NULL, double hashing only
      *   int (*cmp_func)(const void*, const void*) -> NULL for default
      *   uint32_t (*p)(uint32_t, uint32_t, uint32_t) -> NULL for default (linear)
      *   void (*freekey)(void*) -> NULL (no automatic free of keys)
@@ -78,6 +79,7 @@ int main(void)
         0.0f,   /* min_load_factor  */
         0.0f,   /* inactive_factor  */
         NULL,   /* hash_func        */
+        NULL,   /* hash_func2       */
         int_cmp_func,   /* cmp_func         */
         NULL,   /* probe_func       */
         free,   /* freekey          */
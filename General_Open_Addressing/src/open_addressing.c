@@ -6,22 +6,31 @@
  * @date    2024-10-23
  */
 
+#define _POSIX_C_SOURCE 200112L
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include "open_addressing.h"
+#include "basic_func.h"
+#include "probe_iter.h"
 #include "debug_hashtab.h"
 
 #define PRINT_BUFFER_SIZE 1024
 
 /* An entry in the hash table */
 struct htentry {
-    int flag;            /* 0: empty, 1: occupied, 2: deleted            */
+    int flag;            /* 0: empty, 1: occupied, 2: deleted,           *
+                          * 3: occupied, awaiting rehash (purge only)    */
     uint32_t hash_key;   /* Cached hash code for quicker comparison      */
+    uint32_t hash_key2;  /* Secondary hash, the double hashing step      */
     void *key;           /* Pointer to key data                          */
     void *value;         /* Pointer to value data                        */
 };
 
+/* bucket probing sizes its lines from HT_ENTRY_SIZE */
+typedef char htentry_size_matches[sizeof(HTentry) == HT_ENTRY_SIZE ? 1 : -1];
+
 /* a hash table container */
 struct hashtab {
     HTentry *table;      /* Underlying array of entries (slots)          */
@@ -32,10 +41,14 @@ struct hashtab {
     float load_factor;       /* Max load factor before resizing          */
     float min_load_factor;   /* Min load factor to consider downsizing    */
     float inactive_factor;   /* Additional factor for controlling rehash  */
+    float growth_factor;     /* Size multiplier of resize(), 2 keeps      *
+                              * powers of 2, others use prime sizes       */
 
     uint32_t (*hash_func)(void *key, size_t len);
+    uint32_t (*hash_func2)(void *key, size_t len);  /* NULL: step from hash_func */
 	int (*cmp_func)(const void *a, const void *b);
     uint32_t (*p)(uint32_t k, uint32_t i, uint32_t m);
+    ProbeKind probe_kind;    /* inline iterator for p, see probe_iter.h  */
     void (*freekey)(void *k);
     void (*freeval)(void *v);
 };
@@ -45,11 +58,28 @@ struct hashtab {
 static uint32_t default_hash_func(void *key, size_t len);
 static int default_cmp_func(const void *a, const void *b);
 static uint32_t default_probe_func(uint32_t k, uint32_t i, uint32_t m);
-
-static int insert_entry(HashTab *ht, uint32_t hash_key, void *key, void *value);
+static ProbeKind probe_kind_of(uint32_t (*p)(uint32_t k, uint32_t i, uint32_t m));
+
+static uint32_t secondary_hash(const HashTab *ht, void *key, size_t key_len,
+        uint32_t hash_key);
+static int probe_key(HashTab *ht, uint32_t hash_key, uint32_t hash_key2,
+        void *key, uint32_t *slot);
+static void place_entry(HashTab *ht, uint32_t index, uint32_t hash_key,
+        uint32_t hash_key2, void *key, void *value);
+static int insert_entry(HashTab *ht, uint32_t hash_key, uint32_t hash_key2,
+        void *key, void *value);
 static void free_entry(HashTab *ht, HTentry *entry);
-static void rehash_entries(HashTab *ht, HTentry *old_table, uint32_t old_size);
-static void resize(HashTab *ht, uint32_t new_size);
+static int insert_or_grow(HashTab *ht, uint32_t hash_key, uint32_t hash_key2,
+        void *key, void *value);
+static int rehash_entries(HashTab *ht, HTentry *old_table, uint32_t old_size);
+static int resize(HashTab *ht, uint32_t new_size);
+static uint32_t grown_size(const HashTab *ht, uint32_t size);
+static uint32_t table_capacity(const HashTab *ht, uint64_t target);
+static int is_prime(uint32_t n);
+static HTentry *alloc_table(uint32_t size);
+static void purge_tombstones(HashTab *ht);
+static int is_linear_probe(const HashTab *ht);
+static void shift_entries_backward(HashTab *ht, uint32_t hole);
 
 /* --- hash table interface ------------------------------------------------- */
 
@@ -58,6 +88,7 @@ HashTab *init_ht(
         float min_load_factor,
         float inactive_factor,
         uint32_t (*hash_func)(void *key, size_t len),
+        uint32_t (*hash_func2)(void *key, size_t len),
         int (*cmp_func)(const void *a, const void *b),
         uint32_t (*p)(uint32_t k, uint32_t i, uint32_t m),
         void (*freekey)(void *k),
@@ -82,15 +113,18 @@ HashTab *init_ht(
     self->load_factor = (load_factor > 0) ? load_factor : DEFAULT_LOAD_FACTOR;
     self->min_load_factor = (min_load_factor > 0) ? min_load_factor : DEFAULT_MIN_LOAD_FACTOR;
     self->inactive_factor = (inactive_factor > 0) ? inactive_factor : DEFAULT_INACTIVE_FACTOR;
+    self->growth_factor = DEFAULT_GROWTH_FACTOR;
 
     /* Initialize function ptrs withe defaults if NULL */
     self->hash_func = hash_func ? hash_func : default_hash_func;
+    self->hash_func2 = hash_func2;
     self->cmp_func = cmp_func ? cmp_func : default_cmp_func;
     self->p = p ? p : default_probe_func;
+    self->probe_kind = probe_kind_of(self->p);
     self->freekey = freekey ? freekey : NULL;
     self->freeval = freeval ? freeval : NULL;
 
-    self->table = (HTentry *)calloc(self->size, sizeof(HTentry));
+    self->table = alloc_table(self->size);
 	if (self->table == NULL) {
 		fprintf(stderr, "Hashtable allocation failed");
 		exit(EXIT_FAILURE);
@@ -106,8 +140,9 @@ int search_ht(
         void *key,
         size_t key_len
 ) {
-    int flag;
-    uint32_t i, hash_key, index;
+    int index;
+    uint32_t hash_key, hash_key2, slot;
+    HTentry tmp;
 
     DBG_info("search_ht_");
 
@@ -117,26 +152,21 @@ int search_ht(
     }
 
     hash_key = self->hash_func(key, key_len);
-
-    for (i = 0; i < self->size; i++) {
-        index = self->p(hash_key, i, self->size);
-        flag = self->table[index].flag;
-        /* occupied */
-        if (flag == 1 && self->table[index].hash_key == hash_key) {
-            if (self->cmp_func(self->table[index].key, key) == 0) {
-                return index; // key found at index
-            } 
-        /* empty */
-        } else if (flag == 0) {
-            return HT_KEY_NOT_FOUND;
-        }
-        /* handle deleted slots implicitly */
-
+    hash_key2 = secondary_hash(self, key, key_len, hash_key);
+    index = probe_key(self, hash_key, hash_key2, key, &slot);
+
+    /* found past a tombstone: swap the entry into the first tombstone so
+     * later lookups stop earlier, the stale entry keeps its ownership */
+    if (index >= 0 && slot != (uint32_t)index) {
+        tmp = self->table[slot];
+        self->table[slot] = self->table[index];
+        self->table[index] = tmp;
+        index = (int)slot;
     }
-    /* Should never reach this point */
-    DBG_info("_search_ht [HT_INVALID_STATE]");
-    return HT_INVALID_STATE;
-    
+    if (index == HT_INVALID_STATE) {
+        DBG_info("_search_ht [HT_INVALID_STATE]");
+    }
+    return index;
 }
 
 void *fetch_ht(
@@ -155,25 +185,47 @@ int insert_ht(
         size_t key_len,
         void *value
 ) {
-    int flag;
-    uint32_t i, index, hash_key;
+    int index, status;
+    uint32_t hash_key, hash_key2, slot;
 
     if (!self ) {
         return HT_INVALID_ARG;
     }
-    if (search_ht(self, key, key_len) >= 0) {
+    hash_key = self->hash_func(key, key_len);
+    hash_key2 = secondary_hash(self, key, key_len, hash_key);
+    index = probe_key(self, hash_key, hash_key2, key, &slot);
+    if (index >= 0) {
         return HT_KEY_EXISTS;
     }
+    /* a reused tombstone does not raise the load, fill it directly */
+    if (slot != UINT32_MAX && self->table[slot].flag == 2) {
+        place_entry(self, slot, hash_key, hash_key2, key, value);
+        return HT_SUCCESS;
+    }
     if (self->used + 1 > self->size * self->load_factor) {
-        resize(self, self->size * 2);// use bit shift
+        /* mostly tombstones, the live entries fit the current size */
+        if (self->active + 1 <= self->size * self->load_factor / 2) {
+            purge_tombstones(self);
+        } else {
+            status = resize(self, grown_size(self, self->size));
+            if (status != HT_SUCCESS) {
+                return status;
+            }
+        }
+        return insert_or_grow(
+            self,
+            hash_key,
+            hash_key2,
+            key,
+            value
+        );
     }
-    hash_key = self->hash_func(key, key_len);
-    return insert_entry(
-        self,
-        hash_key,
-        key,
-        value
-    );
+    if (slot == UINT32_MAX) {
+        /* the probe sequence never reaches a free slot at this size */
+        return insert_or_grow(self, hash_key, hash_key2, key, value);
+    }
+    place_entry(self, slot, hash_key, hash_key2, key, value);
+    return HT_SUCCESS;
 }
 
 int remove_ht(
@@ -181,36 +233,46 @@ int remove_ht(
         void *key,
         size_t key_len
 ) {
-    uint32_t i, index, hash_key;
-    int flag;
+    int index;
+    uint32_t hash_key, hash_key2, slot;
 
     if (!self ) {
         return HT_INVALID_ARG;
     }
     hash_key = self->hash_func(key, key_len);
-    for (i = 0; i < self->size; i++) {
-        index = self->p(hash_key, i, self->size);
-        flag = self->table[index].flag;
-        /* occupied */
-        if (flag == 1 && self->table[index].hash_key == hash_key) {
-            if (self->cmp_func(self->table[index].key, key) == 0) {
-                self->table[index].flag = 2;
-                self->active--;
-                if (self->active < (float)self->size * self->min_load_factor) {
-                    resize(self, self->size / 2);
-                }
-                if (self->active < (float)self->used * self->inactive_factor) {
-                    resize(self, self->size / 2);
-                }
-                return HT_SUCCESS;
-            } 
-        /* empty */
-        } else if (flag == 0) {
-            return HT_KEY_NOT_FOUND;
-        }
+    hash_key2 = secondary_hash(self, key, key_len, hash_key);
+    index = probe_key(self, hash_key, hash_key2, key, &slot);
+    if (index < 0) {
+        return index;
     }
 
-    return HT_INVALID_STATE;
+    if (is_linear_probe(self)) {
+        /* compact the cluster instead of leaving a tombstone */
+        free_entry(self, &self->table[index]);
+        shift_entries_backward(self, (uint32_t)index);
+        self->used--;
+    } else {
+        self->table[index].flag = 2;
+    }
+    self->active--;
+    if (self->active < (float)self->size * self->min_load_factor) {
+        resize(self, (uint32_t)(self->size / self->growth_factor));
+    }
+    if (self->active < (float)self->used * self->inactive_factor) {
+        purge_tombstones(self);
+    }
+    return HT_SUCCESS;
+}
+
+int set_growth_ht(
+        HashTab *self,
+        float growth_factor
+) {
+    if (!self || !(growth_factor > 1.0f)) {
+        return HT_INVALID_ARG;
+    }
+    self->growth_factor = growth_factor;
+    return HT_SUCCESS;
 }
 
 int free_ht(
@@ -279,43 +341,152 @@ size_t size_ht(
 
 /* --- utility functions ---------------------------------------------------- */
 
-static int insert_entry(
+/**
+ * @brief Secondary hash of a key, only computed for double hashing with a
+ *        hash_func2. Otherwise the step is derived from hash_key itself.
+ */
+static uint32_t secondary_hash(
+        const HashTab *ht,
+        void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    if (ht->hash_func2 && ht->probe_kind == PROBE_DOUBLE_HASH) {
+        return ht->hash_func2(key, key_len);
+    }
+    return hash_key;
+}
+
+/**
+ * @brief Walk the probe sequence of a key once.
+ *
+ * On return *slot holds the first tombstone passed, or failing that the
+ * empty slot that ended the walk (UINT32_MAX when the table has neither).
+ * When the key is found and no tombstone preceded it, *slot is its index.
+ *
+ * @return Index of the key, HT_KEY_NOT_FOUND, or HT_INVALID_STATE when the
+ *         whole sequence was walked without reaching an empty slot.
+ */
+static int probe_key(
         HashTab *ht,
         uint32_t hash_key,
+        uint32_t hash_key2,
         void *key,
-        void *value
+        uint32_t *slot
 ) {
     int flag;
     uint32_t i, index;
+    ProbeIter it;
 
-    for (i = 0; i < ht->size; i++) {
-        index = ht->p(hash_key, i, ht->size);
+    *slot = UINT32_MAX;
+    index = probe_iter_init(&it, ht->probe_kind, ht->p, hash_key, hash_key2, ht->size);
+    for (i = 0; i < ht->size; i++, index = probe_iter_next(&it)) {
         flag = ht->table[index].flag;
-        /* empty */
-        if (flag == 0) {
-            ht->table[index].flag = 1;
-            ht->table[index].hash_key = hash_key;
-            ht->table[index].key = key;           
-            ht->table[index].value = value;
-            ht->active++;
-            ht->used++;
-            return HT_SUCCESS;
         /* occupied */
-        } else if (flag == 1) {
-            continue;
+        if (flag == 1 && ht->table[index].hash_key == hash_key) {
+            if (ht->cmp_func(ht->table[index].key, key) == 0) {
+                if (*slot == UINT32_MAX) {
+                    *slot = index;
+                }
+                return (int)index;
+            }
         /* deleted */
         } else if (flag == 2) {
-            ht->table[index].flag = 1;
-            ht->table[index].hash_key = hash_key;
-            ht->table[index].key = key;           
-            ht->table[index].value = value;
-            ht->active++;
+            if (*slot == UINT32_MAX) {
+                *slot = index;
+            }
+        /* empty */
+        } else if (flag == 0) {
+            if (*slot == UINT32_MAX) {
+                *slot = index;
+            }
+            return HT_KEY_NOT_FOUND;
+        }
+    }
+    return HT_INVALID_STATE;
+}
+
+/**
+ * @brief Store an entry in an empty or deleted slot. The stale key and
+ *        value of a reused tombstone are released first.
+ */
+static void place_entry(
+        HashTab *ht,
+        uint32_t index,
+        uint32_t hash_key,
+        uint32_t hash_key2,
+        void *key,
+        void *value
+) {
+    HTentry *entry = &ht->table[index];
+
+    if (entry->flag == 2) {
+        free_entry(ht, entry);
+    } else {
+        ht->used++;
+    }
+    entry->flag = 1;
+    entry->hash_key = hash_key;
+    entry->hash_key2 = hash_key2;
+    entry->key = key;
+    entry->value = value;
+    ht->active++;
+}
+
+static int insert_entry(
+        HashTab *ht,
+        uint32_t hash_key,
+        uint32_t hash_key2,
+        void *key,
+        void *value
+) {
+    int flag;
+    uint32_t i, index;
+    ProbeIter it;
+
+    index = probe_iter_init(&it, ht->probe_kind, ht->p, hash_key, hash_key2, ht->size);
+    for (i = 0; i < ht->size; i++, index = probe_iter_next(&it)) {
+        flag = ht->table[index].flag;
+        /* empty or deleted */
+        if (flag == 0 || flag == 2) {
+            place_entry(ht, index, hash_key, hash_key2, key, value);
             return HT_SUCCESS;
         }
     }
     return HT_FAILURE;
 }
 
+/**
+ * @brief Insert an entry, growing the table up to HT_GROW_RETRIES times
+ *        while the key's probe sequence has no free slot. Only triangular
+ *        probing on sizes it does not cover can need more than one try.
+ *        A custom probe function is not grown for, it fails with
+ *        HT_FAILURE.
+ */
+static int insert_or_grow(
+        HashTab *ht,
+        uint32_t hash_key,
+        uint32_t hash_key2,
+        void *key,
+        void *value
+) {
+    int attempt, status;
+
+    for (attempt = 0; attempt <= HT_GROW_RETRIES; attempt++) {
+        if (insert_entry(ht, hash_key, hash_key2, key, value) == HT_SUCCESS) {
+            return HT_SUCCESS;
+        }
+        if (ht->probe_kind == PROBE_CUSTOM) {
+            return HT_FAILURE;
+        }
+        status = resize(ht, grown_size(ht, ht->size));
+        if (status != HT_SUCCESS) {
+            return status;
+        }
+    }
+    return HT_NO_SPACE;
+}
+
 static void free_entry(
         HashTab *ht,
         HTentry *entry
@@ -328,47 +499,322 @@ static void free_entry(
     }
 }
 
-static void rehash_entries(
+static int rehash_entries(
         HashTab *ht,
         HTentry *old_table,
         uint32_t old_size
 ) {
     uint32_t i;
     for (i = 0; i < old_size; i++) {
-        if (old_table[i].flag == 1) {
-            insert_entry(
+        if (old_table[i].flag == 1 && insert_entry(
                 ht,
                 old_table[i].hash_key,
+                old_table[i].hash_key2,
                 old_table[i].key,
                 old_table[i].value
-            );
+            ) != HT_SUCCESS) {
+            return HT_FAILURE;
         }
     }
-
+    return HT_SUCCESS;
 }
 
-static void resize(
+/**
+ * @brief Moves the live entries into a table of table_capacity(new_size)
+ *        slots. When an entry finds no free slot on its probe sequence the
+ *        table is grown once more, up to HT_GROW_RETRIES times; the old
+ *        table is only released once every entry is placed.
+ *
+ * @return HT_SUCCESS, HT_MEM_ERROR, HT_NO_SPACE, or HT_FAILURE for a
+ *         custom probe function, the table is unchanged on failure.
+ */
+static int resize(
         HashTab *ht,
         uint32_t new_size
 ) {
     HTentry *old_table, *new_table;
-    uint32_t i, old_size;
-    int insert_status;
+    uint32_t old_size, old_used, old_active;
+    int attempt;
 
     old_size = ht->size;
+    old_used = ht->used;
+    old_active = ht->active;
     old_table = ht->table;
+    new_size = table_capacity(ht, new_size);
 
-    new_table = (HTentry *)calloc(new_size, sizeof(HTentry));
+    for (attempt = 0; attempt <= HT_GROW_RETRIES; attempt++) {
+        new_table = alloc_table(new_size);
+        if (!new_table) {
+            break;
+        }
+        ht->table = new_table;
+        ht->size = new_size;
+        ht->active = 0;
+        ht->used = 0;
+        if (rehash_entries(ht, old_table, old_size) == HT_SUCCESS) {
+            free(old_table);// no good dangling pointers
+            return HT_SUCCESS;
+        }
+        free(new_table);
+        if (ht->probe_kind == PROBE_CUSTOM || new_size >= HT_SIZE_LIMIT) {
+            break;
+        }
+        new_size = table_capacity(ht, grown_size(ht, new_size));
+    }
 
-    ht->table = new_table;
-    ht->size = new_size;
-    ht->active = 0;
-    ht->used = 0;
+    ht->table = old_table;
+    ht->size = old_size;
+    ht->used = old_used;
+    ht->active = old_active;
+    if (!new_table) {
+        return HT_MEM_ERROR;
+    }
+    return ht->probe_kind == PROBE_CUSTOM ? HT_FAILURE : HT_NO_SPACE;
+}
 
-    rehash_entries(ht, old_table, old_size);
-    free(old_table);// no good dangling pointers
+/**
+ * @brief Size a table of size slots grows to: growth_factor times size,
+ *        at least one slot more.
+ */
+static uint32_t grown_size(
+        const HashTab *ht,
+        uint32_t size
+) {
+    uint64_t target = (uint64_t)((double)size * ht->growth_factor + 0.999);
 
+    if (target <= size) {
+        target = (uint64_t)size + 1;
+    }
+    return target > HT_SIZE_LIMIT ? HT_SIZE_LIMIT : (uint32_t)target;
 }
+
+/**
+ * @brief Rounds a requested size up to a usable capacity.
+ *
+ * A growth factor of 2 keeps powers of 2, so probes wrap with a mask.
+ * Other factors round up to a prime, where slots are picked with the
+ * multiply-shift in probe_iter.h and double hashing still reaches every
+ * slot, or for bucket probing to a prime number of cache lines.
+ * Capacities are at least 2 and at most HT_SIZE_LIMIT.
+ */
+static uint32_t table_capacity(
+        const HashTab *ht,
+        uint64_t target
+) {
+    uint32_t n;
+
+    if (target < 2) {
+        target = 2;
+    }
+    if (target > HT_SIZE_LIMIT) {
+        target = HT_SIZE_LIMIT;
+    }
+    n = (uint32_t)target;
+    if (ht->growth_factor == 2.0f) {
+        n--;
+        n |= n >> 1;
+        n |= n >> 2;
+        n |= n >> 4;
+        n |= n >> 8;
+        n |= n >> 16;
+        return n + 1 > HT_SIZE_LIMIT ? HT_SIZE_LIMIT : n + 1;
+    }
+    if (ht->probe_kind == PROBE_BUCKET) {
+        n = (n + HT_LINE_SLOTS - 1) / HT_LINE_SLOTS;
+        while (n < HT_SIZE_LIMIT / HT_LINE_SLOTS && !is_prime(n)) {
+            n++;
+        }
+        return n * HT_LINE_SLOTS;
+    }
+    while (n < HT_SIZE_LIMIT && !is_prime(n)) {
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Zeroed table of size entries, aligned so each group of
+ *        HT_LINE_SLOTS slots shares one cache line.
+ *
+ * @return The table, or NULL when out of memory.
+ */
+static HTentry *alloc_table(
+        uint32_t size
+) {
+    void *table;
+
+    if (posix_memalign(&table, HT_CACHE_LINE, (size_t)size * sizeof(HTentry)) != 0) {
+        return NULL;
+    }
+    memset(table, 0, (size_t)size * sizeof(HTentry));
+    return (HTentry *)table;
+}
+
+/**
+ * @brief Trial division, only run when the table resizes.
+ */
+static int is_prime(
+        uint32_t n
+) {
+    uint32_t d;
+
+    if (n < 4) {
+        return n >= 2;
+    }
+    if (n % 2 == 0) {
+        return 0;
+    }
+    for (d = 3; d <= n / d; d += 2) {
+        if (n % d == 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Drops all tombstones by rehashing the live entries in place.
+ *
+ * Tombstones are freed and emptied and live entries are marked 3. Each
+ * marked entry is then taken out and walks its probe sequence until it
+ * finds an empty slot, or a still marked entry which it swaps with and
+ * carries on placing. Placed entries (1) never move again, so every probe
+ * sequence only passes placed entries. Unlike resize() this needs no
+ * second table.
+ *
+ * @param ht Pointer to the hash table.
+ */
+static void purge_tombstones(
+        HashTab *ht
+) {
+    uint32_t i, j, index;
+    HTentry carry, temp;
+    ProbeIter it;
+
+    for (i = 0; i < ht->size; i++) {
+        if (ht->table[i].flag == 2) {
+            free_entry(ht, &ht->table[i]);
+            ht->table[i].flag = 0;
+            ht->table[i].key = NULL;
+            ht->table[i].value = NULL;
+        } else if (ht->table[i].flag == 1) {
+            ht->table[i].flag = 3;
+        }
+    }
+
+    for (i = 0; i < ht->size; i++) {
+        if (ht->table[i].flag != 3) {
+            continue;
+        }
+        carry = ht->table[i];
+        ht->table[i].flag = 0;
+
+        j = 0;
+        index = probe_iter_init(&it, ht->probe_kind, ht->p, carry.hash_key,
+                carry.hash_key2, ht->size);
+        while (j < ht->size) {
+            if (ht->table[index].flag == 1) {
+                j++;
+                index = probe_iter_next(&it);
+                continue;
+            }
+            temp = ht->table[index];
+            carry.flag = 1;
+            ht->table[index] = carry;
+            if (temp.flag == 0) {
+                break;
+            }
+            /* displaced an unplaced entry, place it next */
+            carry = temp;
+            j = 0;
+            index = probe_iter_init(&it, ht->probe_kind, ht->p, carry.hash_key,
+                carry.hash_key2, ht->size);
+        }
+    }
+    ht->used = ht->active;
+}
+
+/**
+ * @brief Checks whether the table probes linearly, i.e. p(k, i, m) = k + i.
+ *
+ * Only the known linear probe functions qualify, backward shifting relies
+ * on every probe sequence being a contiguous run of slots.
+ *
+ * @param ht Pointer to the hash table.
+ * @return 1 if the probe function is linear, 0 otherwise.
+ */
+static int is_linear_probe(
+        const HashTab *ht
+) {
+    return ht->probe_kind == PROBE_LINEAR;
+}
+
+/**
+ * @brief Maps the library probe functions to their inline iterators.
+ *
+ * The default probe is linear as table sizes are powers of 2.
+ *
+ * @param p Probe function of the table.
+ * @return The matching ProbeKind, PROBE_CUSTOM for any other function.
+ */
+static ProbeKind probe_kind_of(
+        uint32_t (*p)(uint32_t k, uint32_t i, uint32_t m)
+) {
+    if (p == linear_probe_func || p == default_probe_func) {
+        return PROBE_LINEAR;
+    }
+    if (p == quadratic_probe_func) {
+        return PROBE_TRIANGULAR;
+    }
+    if (p == double_hash_probe_func) {
+        return PROBE_DOUBLE_HASH;
+    }
+    if (p == bucket_probe_func) {
+        return PROBE_BUCKET;
+    }
+    return PROBE_CUSTOM;
+}
+
+/**
+ * @brief Fills the slot of a removed entry by shifting its cluster back.
+ *
+ * Knuth's Algorithm R (TAOCP vol. 3, 6.4): walks the cluster after the
+ * hole and moves back every entry whose home slot does not lie cyclically
+ * in (hole, current], so every entry stays reachable from its home slot
+ * without tombstones. Works for any table size.
+ *
+ * @param ht Pointer to the hash table.
+ * @param hole Index of the removed (already freed) entry.
+ */
+static void shift_entries_backward(
+        HashTab *ht,
+        uint32_t hole
+) {
+    uint32_t i, next, home, dist;
+
+    ht->table[hole].flag = 0;
+    for (i = 1; i < ht->size; i++) {
+        next = probe_wrap_add(hole, i, ht->size);
+        if (ht->table[next].flag != 1) {
+            break;
+        }
+        home = probe_home(ht->table[next].hash_key, ht->size);
+        dist = next >= home ? next - home : next + (ht->size - home);
+        /* home between hole and next, the entry must stay behind the hole */
+        if (dist < i) {
+            continue;
+        }
+        ht->table[hole] = ht->table[next];
+        ht->table[next].flag = 0;
+        hole = next;
+        i = 0;
+    }
+    ht->table[hole].hash_key = 0;
+    ht->table[hole].hash_key2 = 0;
+    ht->table[hole].key = NULL;
+    ht->table[hole].value = NULL;
+}
+
 /* --- default functions ---------------------------------------------------- */
 
 /* Default hash function preforms a modified FNV-1a hash on the key bytes */
@@ -394,5 +840,5 @@ static int default_cmp_func(const void *a, const void *b) {
 }
 
 static uint32_t default_probe_func(uint32_t k, uint32_t i, uint32_t m) {
-    return (k + i) % m;
+    return linear_probe_func(k, i, m);
 }
@@ -1,22 +1,59 @@
 #include <stdint.h>     
 #include <stdlib.h>
 #include <basic_func.h>
+#include <probe_iter.h>
 
-/* Example linear and quadratic probe functions */
+/* Example linear and quadratic probe functions. Power-of-2 sizes mask the
+ * low bits of k, any other size starts from the multiply-shift home slot,
+ * matching the iterators in probe_iter.h */
 uint32_t linear_probe_func(uint32_t k, uint32_t i, uint32_t m) {
-    return (k + i) & (m - 1);
+    if ((m & (m - 1)) == 0) {
+        return (k + i) & (m - 1);
+    }
+    return (uint32_t)(((uint64_t)probe_home(k, m) + i) % m);
 }
 
+// Triangular numbers, (k + i(i+1)/2) mod m, visit every slot when m is a
+// power of 2 where k + i^2 reaches only a fraction of them
 uint32_t quadratic_probe_func(uint32_t k, uint32_t i, uint32_t m) {
-    // Basic example: (k + i^2) mod m
-    return (k + i * i) & (m - 1);//(k + i * i) % m;
+    uint64_t offset = (uint64_t)i * (i + 1) / 2;
+
+    if ((m & (m - 1)) == 0) {
+        return (k + (uint32_t)offset) & (m - 1);
+    }
+    return (uint32_t)((probe_home(k, m) + offset % m) % m);
 }
 
-// only covers entire m when m power of 2
+// only covers entire m when m power of 2 or prime
 uint32_t double_hash_probe_func(uint32_t k, uint32_t i, uint32_t m) {
     uint32_t h1, h2;
-    h1 = k;
-    h2 = (k << 1) | 1;
-    return (h1 + i*h2) & (m - 1);
+    h1 = probe_home(k, m);
+    h2 = probe_step(k, m);
+    if ((m & (m - 1)) == 0) {
+        return (h1 + i*h2) & (m - 1);
+    }
+    return (uint32_t)((h1 + (uint64_t)i * h2) % m);
+}
+
+// Scans the HT_LINE_SLOTS slots of the home slot's cache line before
+// leaving it, then jumps to the same offset in another line: triangular
+// line jumps for power-of-2 m, double hashing over a prime number of lines
+// otherwise. Falls back to linear when m is not a whole number of lines
+uint32_t bucket_probe_func(uint32_t k, uint32_t i, uint32_t m) {
+    uint32_t h, offset, base, j;
 
+    if (!probe_bucket_fits(m)) {
+        return linear_probe_func(k, i, m);
+    }
+    h = probe_home(k, m);
+    offset = h & (HT_LINE_SLOTS - 1);
+    base = h - offset;
+    j = i / HT_LINE_SLOTS;
+    if ((m & (m - 1)) == 0) {
+        base = (base + HT_LINE_SLOTS * (uint32_t)((uint64_t)j * (j + 1) / 2)) & (m - 1);
+    } else {
+        base = (uint32_t)((base + (uint64_t)HT_LINE_SLOTS *
+                ((uint64_t)j * probe_line_step(k, m) % (m / HT_LINE_SLOTS))) % m);
+    }
+    return base + ((offset + i) & (HT_LINE_SLOTS - 1));
 }
@@ -58,6 +58,7 @@ HashTab *init_ht(
         float min_load_factor,
         float inactive_factor,
         uint32_t (*hash_func)(void *key, size_t len),
+        uint32_t (*hash_func2)(void *key, size_t len),
         int (*cmp_func)(const void *a, const void *b),
         uint32_t (*p)(uint32_t k, uint32_t i, uint32_t m),
         void (*freekey)(void *k),
@@ -85,6 +86,7 @@ HashTab *init_ht(
 
     /* Initialize function ptrs withe defaults if NULL */
     self->hash_func = hash_func ? hash_func : default_hash_func;
+    (void)hash_func2;    /* robin hood probing has no double hashing step */
     self->cmp_func = cmp_func ? cmp_func : default_cmp_func;
     self->p = p ? p : default_probe_func;
     self->freekey = freekey ? freekey : NULL;
@@ -7,6 +7,8 @@
 #include <getopt.h>
 #include <basic_func.h>
 #include <open_addressing.h>
+#include <cpu_dispatch.h>
+#include <probe_iter.h>
 
 /* --- Types and Constants ------------------------------------------------- */
 
@@ -38,7 +40,20 @@
 #define DEFAULT_P_REMOVE 0.2
 #endif
 
+#ifndef DEFAULT_STRIDE
+#define DEFAULT_STRIDE 1024
+#endif
+
+#ifndef AVALANCHE_SAMPLES
+#define AVALANCHE_SAMPLES 256
+#endif
+
+#ifndef QUALITY_SEED
+#define QUALITY_SEED 0x2545F4914F6CDD1Dull
+#endif
+
 #define OUTPUT_DIR "benchmark/results/"
+#define WORDS_FILE "/usr/share/dict/words"
 
 typedef struct {
     char *description;
@@ -49,7 +64,9 @@ typedef struct {
     float load_factor;
     float min_load_factor;
     float inactive_factor;
+    float growth_factor;
     uint32_t (*hash_func)(void *key, size_t len);
+    uint32_t (*hash_func2)(void *key, size_t len);
     int (*cmp_func)(const void *key1, const void *key2);
     uint32_t (*p)(uint32_t k, uint32_t i, uint32_t m);
     void (*freekey)(void *k);
@@ -57,20 +74,48 @@ typedef struct {
     const char *output_file;
 } BenchConfig;
 
+/** Keys of one distribution, packed back to back in data */
+typedef struct {
+    const char *name;
+    unsigned char *data;
+    void **keys;
+    size_t *lens;
+    size_t n;
+} KeySet;
+
+/** Quality of one hash function and probe sequence over one KeySet */
+typedef struct {
+    size_t slots;
+    size_t failed;             // keys with no free slot on their probe sequence
+    size_t *probe_hist;        // probe_hist[i]: keys placed on their i-th probe
+    double mean_probe;
+    size_t p99_probe;
+    size_t max_probe;
+    size_t max_cluster;        // longest run of occupied slots
+    double chi2;               // home slot uniformity, df = slots - 1
+    double chi2_z;             // (chi2 - df) / sqrt(2 df), |z| > 3 is suspect
+    double avalanche_bias;     // mean |P(output bit flips) - 0.5| * 2
+    double avalanche_worst;    // worst input bit / output bit pair
+} QualityStats;
+
 #define C2HASHFN(func_ptr) ((uint32_t (*)(void *, size_t))func_ptr)
 static const FunctionEntry hash_func_arr[] = {
     {"djb2", (void *)djb2_hash},
     {"sdbm", (void *)sdbm_hash},
     {"fnv1a", (void *)fnv1a_hash},
     {"murmur3_32", (void *)murmur3_32_hash},
-    {"crc32", (void *)crc32_hash}
+    {"crc32", (void *)crc32_hash},
+    {"crc32c", (void *)crc32c_hash},
+    {"wyhash_32", (void *)wyhash_32_hash},
+    {"int32", (void *)int32_hash}
 };
 
 #define C2PROBEFN(func_ptr) ((uint32_t (*)(uint32_t, uint32_t, uint32_t))func_ptr)
 static const FunctionEntry probe_func_arr[] = {
     {"linear", (void *)linear_probe_func},
     {"quadratic", (void *)quadratic_probe_func},
-    {"double_hash", (void *)double_hash_probe_func}
+    {"double_hash", (void *)double_hash_probe_func},
+    {"bucket", (void *)bucket_probe_func}
 };
 /* --- Benchmarking Function Prototypes ----------------------------------- */
 
@@ -101,6 +146,24 @@ static void mixed_benchmark(
         const double p_remove
 );
 
+/**
+ * @brief Measure how evenly each hash spreads each key distribution and how
+ *        long the probe sequences get.
+ *
+ * The table is simulated at the size a real table grows to for num_keys at
+ * config->load_factor and config->growth_factor, so probe lengths are those
+ * of a table that never rehashed. One row per hash x probe x key set goes to the CSV, and the
+ * probe length histograms go to a second CSV next to it. The extra probe
+ * double_hash2 takes its step from a secondary hash, as init_ht does when
+ * given hash_func2.
+ *
+ * @param config     Load and growth factor and output file, hash_func and p select a
+ *                   single hash or probe when not NULL, hash_func2 is the
+ *                   secondary hash (wyhash_32 or murmur3_32 when NULL).
+ * @param num_keys   Keys per distribution.
+ */
+static void quality_benchmark(const BenchConfig *config, size_t num_keys);
+
 /* --- Helper Function Prototypes ------------------------------------------ */
 
 /**
@@ -140,6 +203,43 @@ static char *generate_output_filename(
  */
 static double time_diff(struct timespec start, struct timespec end);
 
+/**
+ * @brief Fill a KeySet with n keys of the named distribution.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int make_keyset(KeySet *set, const char *name, size_t n);
+static void free_keyset(KeySet *set);
+
+/**
+ * @brief Number of slots a table built with config holds after n inserts.
+ *
+ * @return The table size, 0 on allocation failure.
+ */
+static size_t grown_slots(const BenchConfig *config, size_t n);
+
+/**
+ * @brief Insert every key of set into a simulated table of the given number
+ *        of slots and fill in stats. With hash2_fn the table double hashes
+ *        with a secondary hash and probe_fn is ignored.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int measure_quality(
+        const KeySet *set,
+        uint32_t (*hash_fn)(void *, size_t),
+        uint32_t (*probe_fn)(uint32_t, uint32_t, uint32_t),
+        uint32_t (*hash2_fn)(void *, size_t),
+        size_t slots,
+        QualityStats *stats
+);
+static double avalanche_bias(
+        const KeySet *set,
+        uint32_t (*hash_fn)(void *, size_t),
+        double *worst
+);
+static uint64_t next_rand(uint64_t *state);
+
 /* --- CLI Function Prototypes --------------------------------------------- */
 
 static void print_usage(const char *prog_name);
@@ -217,6 +317,7 @@ static void avg_insert_benchmark(const BenchConfig *config, size_t num_tests) {
         config->min_load_factor,
         config->inactive_factor,
         config->hash_func,
+        config->hash_func2,
         config->cmp_func,
         config->p,
         config->freekey,
@@ -227,6 +328,7 @@ static void avg_insert_benchmark(const BenchConfig *config, size_t num_tests) {
         free(insert_times);
         return;
     }
+    set_growth_ht(ht, config->growth_factor);
 
     for (size_t i = 0; i < num_tests; i++) {
         // Allocate and initialize key
@@ -318,6 +420,7 @@ static void avg_lookup_benchmark(const BenchConfig *config, size_t num_tests) {
         config->min_load_factor,
         config->inactive_factor,
         config->hash_func,
+        config->hash_func2,
         config->cmp_func,
         config->p,
         config->freekey,
@@ -328,6 +431,7 @@ static void avg_lookup_benchmark(const BenchConfig *config, size_t num_tests) {
         free(lookup_times);
         return;
     }
+    set_growth_ht(ht, config->growth_factor);
 
     /* 
      * Populate the table so that lookups are meaningful.
@@ -424,22 +528,25 @@ static void mixed_benchmark(
         *keys[i] = (int)i;
         *vals[i] = (int)(i + 500);
     }
-    /* Initialize hash table. */
+    /* Initialize hash table. The benchmark keeps ownership of keys and
+     * values, removed keys stay valid and may be looked up or removed again */
     HashTab *ht = init_ht(
             config->load_factor,
             config->min_load_factor,
             config->inactive_factor,
             config->hash_func,
+            config->hash_func2,
             config->cmp_func,
             config->p,
-            config->freekey,
-            config->freeval
+            NULL,
+            NULL
     );
 
     if (!ht) {
         fprintf(stderr, "Failed to initialize hash table.\n");
         goto cleanup_mixed;
     }
+    set_growth_ht(ht, config->growth_factor);
 
     /* Warm-up phase: perform a few operations. */
     size_t warmup = num_ops / 10;
@@ -477,11 +584,7 @@ static void mixed_benchmark(
                 size_t idx =rand() % num_inserts;
                 //fprintf(stderr, "&keys[idx]:%p idx:%zu i:%zu num_in:%zu\n",
                 //        (void *)&keys[idx], idx, i, num_inserts);
-                if (remove_ht(ht, keys[idx], sizeof(int)) == HT_SUCCESS) {
-                    keys[idx] = NULL;
-                    vals[idx] = NULL;
-                }
-                /* TODO:adjust num_inserts, or allow duplicate removals. */
+                remove_ht(ht, keys[idx], sizeof(int));
             }
         }
         clock_gettime(CLOCK_MONOTONIC, &end);
@@ -512,17 +615,406 @@ cleanup_mixed:
     free(op_times);
 }   
 
+/* --- Quality Benchmark --------------------------------------------------- */
+
+static const char *const keyset_names[] = {
+    "sequential", "strided", "random", "words", "uuid", "url"
+};
+
+static uint64_t next_rand(uint64_t *state) {
+    // xorshift64*, fixed seed so every run sees the same keys
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1Dull;
+}
+
+/**
+ * @brief Spell i as syllables, giving distinct word-like keys when no word
+ *        list is installed.
+ */
+static size_t make_word(size_t i, char *out) {
+    static const char *const syllables[] = {
+        "the", "an", "re", "in", "er", "on", "at", "en", "es", "or",
+        "ti", "ing", "ste", "al", "ar", "le", "de", "se", "ro", "ly",
+        "ent", "co", "ma", "pe", "ca", "ba", "li", "so", "ve", "mi"
+    };
+    const size_t count = sizeof(syllables) / sizeof(syllables[0]);
+    size_t len = 0;
+
+    do {
+        const char *syl = syllables[i % count];
+        size_t n = strlen(syl);
+        memcpy(out + len, syl, n);
+        len += n;
+        i /= count;
+    } while (i);
+    return len;
+}
+
+static int make_keyset(KeySet *set, const char *name, size_t n) {
+    // Longest key: a 36 char UUID or a URL path
+    const size_t max_len = 64;
+    uint64_t rng = QUALITY_SEED;
+    FILE *words = NULL;
+    char line[256];
+    size_t used = 0;
+
+    memset(set, 0, sizeof(*set));
+    set->name = name;
+    set->data = malloc(n * max_len);
+    set->keys = malloc(n * sizeof(void *));
+    set->lens = malloc(n * sizeof(size_t));
+    if (!set->data || !set->keys || !set->lens) {
+        free_keyset(set);
+        return -1;
+    }
+    if (strcmp(name, "words") == 0) {
+        words = fopen(WORDS_FILE, "r");
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        unsigned char *key = set->data + used;
+        size_t len = sizeof(uint32_t);
+        uint32_t k32;
+
+        if (strcmp(name, "sequential") == 0) {
+            k32 = (uint32_t)i;
+            memcpy(key, &k32, len);
+        } else if (strcmp(name, "strided") == 0) {
+            k32 = (uint32_t)(i * DEFAULT_STRIDE);
+            memcpy(key, &k32, len);
+        } else if (strcmp(name, "random") == 0) {
+            k32 = (uint32_t)(next_rand(&rng) >> 32);
+            memcpy(key, &k32, len);
+        } else if (strcmp(name, "words") == 0) {
+            if (words && fgets(line, sizeof(line), words)) {
+                len = strcspn(line, "\r\n");
+                if (len > max_len) {len = max_len;}
+                memcpy(key, line, len);
+            } else {
+                len = make_word(i, (char *)key);
+            }
+        } else if (strcmp(name, "uuid") == 0) {
+            uint64_t hi = next_rand(&rng), lo = next_rand(&rng);
+            // version 4, variant 10xx
+            hi = (hi & ~0xF000ull) | 0x4000ull;
+            lo = (lo & ~(0xC000ull << 48)) | (0x8000ull << 48);
+            len = (size_t)snprintf((char *)key, max_len,
+                    "%08x-%04x-%04x-%04x-%012llx",
+                    (unsigned)(hi >> 32), (unsigned)(hi >> 16) & 0xFFFF,
+                    (unsigned)hi & 0xFFFF, (unsigned)(lo >> 48),
+                    (unsigned long long)(lo & 0xFFFFFFFFFFFFull));
+        } else {
+            static const char *const resources[] = {
+                "users", "orders", "products", "sessions", "images", "comments"
+            };
+            const char *res = resources[next_rand(&rng) % 6];
+            // the id keeps the path unique, the suffix varies the shape
+            len = (size_t)snprintf((char *)key, max_len, "/api/v%u/%s/%zu%s",
+                    (unsigned)(next_rand(&rng) % 3) + 1, res, i,
+                    (i & 1) ? "/details" : "");
+        }
+        set->keys[i] = key;
+        set->lens[i] = len;
+        used += len;
+    }
+    if (words) {
+        fclose(words);
+    }
+    set->n = n;
+    return 0;
+}
+
+static void free_keyset(KeySet *set) {
+    free(set->data);
+    free(set->keys);
+    free(set->lens);
+    memset(set, 0, sizeof(*set));
+}
+
+static double avalanche_bias(
+        const KeySet *set,
+        uint32_t (*hash_fn)(void *, size_t),
+        double *worst
+) {
+    unsigned char buf[64];
+    size_t samples = set->n < AVALANCHE_SAMPLES ? set->n : AVALANCHE_SAMPLES;
+    size_t max_bits = 0;
+    size_t *flips, *trials;
+    double total = 0.0;
+    size_t cells = 0;
+
+    *worst = 0.0;
+    for (size_t s = 0; s < samples; s++) {
+        if (set->lens[s] * 8 > max_bits) {max_bits = set->lens[s] * 8;}
+    }
+    flips = calloc(max_bits * 32, sizeof(size_t));
+    trials = calloc(max_bits, sizeof(size_t));
+    if (!flips || !trials) {
+        free(flips);
+        free(trials);
+        return -1.0;
+    }
+
+    // Flip each input bit of each sampled key and count flipped output bits
+    for (size_t s = 0; s < samples; s++) {
+        size_t len = set->lens[s];
+        uint32_t base;
+
+        memcpy(buf, set->keys[s], len);
+        base = hash_fn(buf, len);
+        for (size_t bit = 0; bit < len * 8; bit++) {
+            buf[bit / 8] ^= (unsigned char)(1u << (bit % 8));
+            uint32_t diff = base ^ hash_fn(buf, len);
+            buf[bit / 8] ^= (unsigned char)(1u << (bit % 8));
+            for (int out = 0; out < 32; out++) {
+                flips[bit * 32 + out] += (diff >> out) & 1u;
+            }
+            trials[bit]++;
+        }
+    }
+
+    for (size_t bit = 0; bit < max_bits; bit++) {
+        if (!trials[bit]) {continue;}
+        for (int out = 0; out < 32; out++) {
+            double p = (double)flips[bit * 32 + out] / (double)trials[bit];
+            double bias = fabs(p - 0.5) * 2.0;
+            total += bias;
+            cells++;
+            if (bias > *worst) {*worst = bias;}
+        }
+    }
+    free(flips);
+    free(trials);
+    return cells ? total / (double)cells : 0.0;
+}
+
+static size_t grown_slots(
+        const BenchConfig *config,
+        size_t n
+) {
+    uint32_t *keys = malloc(n * sizeof(uint32_t));
+    HashTab *ht;
+    size_t slots;
+
+    if (!keys) {return 0;}
+    ht = init_ht(config->load_factor, config->min_load_factor,
+                 config->inactive_factor, int32_hash, NULL, int_cmp,
+                 config->p, NULL, NULL);
+    set_growth_ht(ht, config->growth_factor);
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = (uint32_t)i;
+        insert_ht(ht, &keys[i], sizeof(uint32_t), NULL);
+    }
+    slots = size_ht(ht);
+    free_ht(ht);
+    free(keys);
+    return slots;
+}
+
+static int measure_quality(
+        const KeySet *set,
+        uint32_t (*hash_fn)(void *, size_t),
+        uint32_t (*probe_fn)(uint32_t, uint32_t, uint32_t),
+        uint32_t (*hash2_fn)(void *, size_t),
+        size_t slots,
+        QualityStats *stats
+) {
+    size_t placed = 0, run = 0, first_run = 0;
+    size_t *home;
+    unsigned char *occupied;
+    double sum = 0.0, expected;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->slots = slots;
+    stats->probe_hist = calloc(slots + 1, sizeof(size_t));
+    home = calloc(slots, sizeof(size_t));
+    occupied = calloc(slots, 1);
+    if (!stats->probe_hist || !home || !occupied) {
+        free(stats->probe_hist);
+        stats->probe_hist = NULL;
+        free(home);
+        free(occupied);
+        return -1;
+    }
+
+    for (size_t k = 0; k < set->n; k++) {
+        uint32_t hash_key = hash_fn(set->keys[k], set->lens[k]);
+        uint32_t hash_key2 = hash2_fn ? hash2_fn(set->keys[k], set->lens[k]) : hash_key;
+        ProbeIter it;
+        uint32_t index;
+        size_t i;
+
+        home[probe_home(hash_key, (uint32_t)slots)]++;
+        index = probe_iter_init(&it, hash2_fn ? PROBE_DOUBLE_HASH : PROBE_CUSTOM,
+                                probe_fn, hash_key, hash_key2, (uint32_t)slots);
+        for (i = 0; i < slots; i++, index = probe_iter_next(&it)) {
+            if (!occupied[index]) {
+                occupied[index] = 1;
+                break;
+            }
+        }
+        if (i == slots) {
+            stats->failed++;
+            continue;
+        }
+        stats->probe_hist[i + 1]++;
+        sum += (double)(i + 1);
+        placed++;
+    }
+
+    if (placed) {
+        size_t seen = 0, target = (size_t)ceil(0.99 * (double)placed);
+        stats->mean_probe = sum / (double)placed;
+        for (size_t len = 1; len <= slots; len++) {
+            if (!stats->probe_hist[len]) {continue;}
+            seen += stats->probe_hist[len];
+            if (!stats->p99_probe && seen >= target) {stats->p99_probe = len;}
+            stats->max_probe = len;
+        }
+    }
+
+    // Longest run of occupied slots, wrapping around the end of the table
+    for (size_t i = 0; i < slots && occupied[i]; i++) {
+        first_run++;
+    }
+    for (size_t i = first_run; i < slots; i++) {
+        run = occupied[i] ? run + 1 : 0;
+        if (run > stats->max_cluster) {stats->max_cluster = run;}
+    }
+    if (first_run == slots) {
+        stats->max_cluster = slots;
+    } else if (run + first_run > stats->max_cluster) {
+        stats->max_cluster = run + first_run;
+    }
+
+    expected = (double)set->n / (double)slots;
+    for (size_t i = 0; i < slots; i++) {
+        double d = (double)home[i] - expected;
+        stats->chi2 += d * d / expected;
+    }
+    stats->chi2_z = (stats->chi2 - (double)(slots - 1)) / sqrt(2.0 * (double)(slots - 1));
+    stats->avalanche_bias = avalanche_bias(set, hash_fn, &stats->avalanche_worst);
+
+    free(home);
+    free(occupied);
+    return 0;
+}
+
+static void quality_benchmark(const BenchConfig *config, size_t num_keys) {
+    const size_t num_sets = sizeof(keyset_names) / sizeof(keyset_names[0]);
+    const size_t num_hashes = sizeof(hash_func_arr) / sizeof(hash_func_arr[0]);
+    const size_t num_probes = sizeof(probe_func_arr) / sizeof(probe_func_arr[0]);
+    char hist_file[DEFAULT_BUFFER];
+    FILE *fp, *hist_fp;
+    const char *dot;
+    size_t slots;
+
+    if (!config || !config->output_file) {
+        fprintf(stderr, "quality_benchmark: Invalid BenchConfig.\n");
+        return;
+    }
+    slots = grown_slots(config, num_keys);
+    if (!slots) {
+        fprintf(stderr, "quality_benchmark: Failed to size the table.\n");
+        return;
+    }
+    // results.csv -> results_probes.csv
+    dot = strrchr(config->output_file, '.');
+    snprintf(hist_file, sizeof(hist_file), "%.*s_probes.csv",
+             (int)(dot ? (size_t)(dot - config->output_file) : strlen(config->output_file)),
+             config->output_file);
+
+    fp = fopen(config->output_file, "w");
+    hist_fp = fopen(hist_file, "w");
+    if (!fp || !hist_fp) {
+        perror("fopen quality csv");
+        if (fp) {fclose(fp);}
+        if (hist_fp) {fclose(hist_fp);}
+        return;
+    }
+    fprintf(fp, "Hash,Probe,KeySet,Keys,Slots,Failed,MeanProbe,P99Probe,MaxProbe,"
+                "MaxCluster,ChiSquared,ChiSquaredZ,AvalancheBias,AvalancheWorst\n");
+    fprintf(hist_fp, "Hash,Probe,KeySet,ProbeLength,Count\n");
+
+    for (size_t s = 0; s < num_sets; s++) {
+        KeySet set;
+        if (make_keyset(&set, keyset_names[s], num_keys) != 0) {
+            fprintf(stderr, "Failed to generate '%s' keys.\n", keyset_names[s]);
+            continue;
+        }
+        for (size_t h = 0; h < num_hashes; h++) {
+            uint32_t (*hash_fn)(void *, size_t) = C2HASHFN(hash_func_arr[h].func_ptr);
+            if (config->hash_func && config->hash_func != hash_fn) {continue;}
+            // int32 reads exactly 4 bytes, it only applies to the integer sets
+            if (hash_fn == int32_hash && set.lens[0] != sizeof(uint32_t)) {continue;}
+
+            // p == num_probes is double hashing with a secondary hash
+            for (size_t p = 0; p <= num_probes; p++) {
+                uint32_t (*probe_fn)(uint32_t, uint32_t, uint32_t) = p < num_probes ?
+                    C2PROBEFN(probe_func_arr[p].func_ptr) : double_hash_probe_func;
+                uint32_t (*hash2_fn)(void *, size_t) = NULL;
+                const char *probe_name = p < num_probes ?
+                    probe_func_arr[p].description : "double_hash2";
+                QualityStats stats;
+                if (config->p && config->p != probe_fn) {continue;}
+                if (p == num_probes) {
+                    hash2_fn = config->hash_func2 ? config->hash_func2 :
+                        hash_fn == wyhash_32_hash ? murmur3_32_hash : wyhash_32_hash;
+                }
+
+                if (measure_quality(&set, hash_fn, probe_fn, hash2_fn,
+                                    slots, &stats) != 0) {
+                    fprintf(stderr, "Failed to measure %s/%s on '%s'.\n",
+                            hash_func_arr[h].description, probe_name, set.name);
+                    continue;
+                }
+                fprintf(fp, "%s,%s,%s,%zu,%zu,%zu,%.4f,%zu,%zu,%zu,%.2f,%.3f,%.5f,%.5f\n",
+                        hash_func_arr[h].description, probe_name,
+                        set.name, set.n, stats.slots, stats.failed, stats.mean_probe,
+                        stats.p99_probe, stats.max_probe, stats.max_cluster,
+                        stats.chi2, stats.chi2_z, stats.avalanche_bias,
+                        stats.avalanche_worst);
+                for (size_t len = 1; len <= stats.slots; len++) {
+                    if (stats.probe_hist[len]) {
+                        fprintf(hist_fp, "%s,%s,%s,%zu,%zu\n",
+                                hash_func_arr[h].description, probe_name,
+                                set.name, len, stats.probe_hist[len]);
+                    }
+                }
+                free(stats.probe_hist);
+            }
+        }
+        free_keyset(&set);
+    }
+
+    fclose(fp);
+    fclose(hist_fp);
+    printf("Quality benchmark completed. Results written to '%s' and '%s'\n",
+           config->output_file, hist_file);
+}
+
 /* --- CLI Functions ------------------------------------------------------- */
 static void print_usage(const char *prog_name) {
     fprintf(stderr, "Usage: %s [OPTIONS]\n", prog_name);
     fprintf(stderr, "  --help, -h               Print this help message\n");
-    fprintf(stderr, "  --mode, -m <insert|lookup|both>  Benchmark mode\n");
+    fprintf(stderr, "  --mode, -m <insert|lookup|mixed|quality>  Benchmark mode\n");
     fprintf(stderr, "  --probe, -p <STR>        Probe function to use\n");
     fprintf(stderr, "  --hash, -H <STR>         Hash function to use\n");
+    fprintf(stderr, "  --hash2, -S <STR>        Secondary hash setting the double_hash step\n");
+    fprintf(stderr, "  --growth, -g <F>         Table growth factor (float > 1),"
+                    "default=%.2f\n", DEFAULT_GROWTH_FACTOR);
     fprintf(stderr, "  --load-factor, -l <F>    Load factor (float),"
                     "default=%.2f\n", DEFAULT_LOAD_FACTOR);
     fprintf(stderr, "  --num-tests, -n <N>      Number of operations, e.g. 100000\n");
     fprintf(stderr, "  --output-file, -o <FILE> Where to write CSV\n");
+    fprintf(stderr, "\nQuality mode runs every hash and probe (or the ones given)"
+                    " over each key set:\n ");
+    for (size_t i = 0; i < sizeof(keyset_names) / sizeof(keyset_names[0]); i++) {
+        fprintf(stderr, " %s", keyset_names[i]);
+    }
+    fprintf(stderr, "\n");
 
     // Print available probes from probe_func_arr
     fprintf(stderr, "\nAvailable probes:\n");
@@ -533,7 +1025,7 @@ static void print_usage(const char *prog_name) {
 
     // Print available hashes from hash_func_arr
     fprintf(stderr, "\nAvailable hash functions:\n");
-    // Example:   djb2, sdbm, fnv1a, murmur3_32, crc32
+    // Example:   djb2, sdbm, fnv1a, murmur3_32, crc32, crc32c, wyhash_32, int32
     for (size_t i = 0; i < sizeof(hash_func_arr) / sizeof(hash_func_arr[0]); i++) {
         fprintf(stderr, "  %s\n", hash_func_arr[i].description);
     }
@@ -543,6 +1035,8 @@ static void print_usage(const char *prog_name) {
                     " --num-tests 100000 --output-file my_insert.csv\n", prog_name);
     fprintf(stderr, "  %s --mode lookup --probe double_hash --hash crc32"
                     " --num-tests 50000 --output-file my_lookup.csv\n", prog_name);
+    fprintf(stderr, "  %s --mode quality --num-tests 100000"
+                    " --output-file quality.csv\n", prog_name);
 }
 /* --- Main Function ------------------------------------------------------- */
 
@@ -551,9 +1045,11 @@ int main(int argc, char *argv[]) {
     const char *mode_str       = "lookup";
     const char *probe_str      = NULL;
     const char *hash_str       = NULL;     
+    const char *hash2_str      = NULL;
     float load_factor          = DEFAULT_LOAD_FACTOR;
     float min_load_factor      = DEFAULT_MIN_LOAD_FACTOR;
     float inactive_factor      = DEFAULT_INACTIVE_FACTOR;
+    float growth_factor        = DEFAULT_GROWTH_FACTOR;
     size_t num_tests           = 100000;
     const char *output_file    = NULL;
 
@@ -563,13 +1059,15 @@ int main(int argc, char *argv[]) {
         {"mode",        required_argument, NULL, 'm'},
         {"probe",       required_argument, NULL, 'p'},
         {"hash",        required_argument, NULL, 'H'},
+        {"hash2",       required_argument, NULL, 'S'},
+        {"growth",      required_argument, NULL, 'g'},
         {"load-factor", required_argument, NULL, 'l'},
         {"num-tests",   required_argument, NULL, 'n'},
         {"output-file", required_argument, NULL, 'o'},
         {0, 0, 0, 0}
     };
 
-    const char *short_opts = "hm:p:H:l:n:o:"; 
+    const char *short_opts = "hm:p:H:S:g:l:n:o:"; 
     int opt, long_index = 0;
 
     while ((opt = getopt_long(argc, argv, short_opts, long_opts, &long_index)) != -1) {
@@ -586,6 +1084,16 @@ int main(int argc, char *argv[]) {
             case 'H':
                 hash_str = optarg;
                 break;
+            case 'S':
+                hash2_str = optarg;
+                break;
+            case 'g':
+                growth_factor = strtof(optarg, NULL);
+                if (!(growth_factor > 1.0f)) {
+                    fprintf(stderr, "Error: --growth must be > 1\n");
+                    return 1;
+                }
+                break;
             case 'l':
                 load_factor = strtof(optarg, NULL);
                 break;
@@ -611,16 +1119,19 @@ int main(int argc, char *argv[]) {
     int do_insert = 0;
     int do_lookup = 0;
     int do_mixed = 0;
+    int do_quality = 0;
     if (strcmp(mode_str, "insert") == 0) {
         do_insert = 1;
     } else if (strcmp(mode_str, "lookup") == 0) {
         do_lookup = 1;
     } else if (strcmp(mode_str, "mixed") == 0) {
         do_mixed = 1;
+    } else if (strcmp(mode_str, "quality") == 0) {
+        do_quality = 1;
     } else {
         fprintf(
                 stderr,
-                "Unknown mode '%s'. Must be 'insert', 'lookup', or 'mixed'.\n",
+                "Unknown mode '%s'. Must be 'insert', 'lookup', 'mixed' or 'quality'.\n",
                 mode_str
         );
         return 1;
@@ -641,7 +1152,7 @@ int main(int argc, char *argv[]) {
             fprintf(stderr, "Error: Unrecognized probe '%s'\n", probe_str);
             return 1;
         }
-    } else {
+    } else if (!do_quality) {
         // If user didn't specify, pick the first or some default
         probe_fn = C2PROBEFN(probe_func_arr[0].func_ptr);
     }
@@ -661,17 +1172,36 @@ int main(int argc, char *argv[]) {
             fprintf(stderr, "Error: Unrecognized hash '%s'\n", hash_str);
             return 1;
         }
-    } else {
+    } else if (!do_quality) {
         // If user didn't specify, pick the first or some default
         hash_fn = C2HASHFN(hash_func_arr[0].func_ptr);
     }
 
+    // Find the optional secondary hash, NULL steps from the primary hash
+    uint32_t (*hash2_fn)(void *, size_t) = NULL;
+    if (hash2_str) {
+        for (size_t i = 0; i < sizeof(hash_func_arr)/sizeof(hash_func_arr[0]); i++) {
+            if (strcmp(hash2_str, hash_func_arr[i].description) == 0) {
+                hash2_fn = C2HASHFN(hash_func_arr[i].func_ptr);
+                break;
+            }
+        }
+        if (!hash2_fn) {
+            fprintf(stderr, "Error: Unrecognized hash '%s'\n", hash2_str);
+            return 1;
+        }
+    }
+
+    // Quality mode covers every hash and probe that was not pinned
+    const char *default_probe = do_quality ? "all" : probe_func_arr[0].description;
+    const char *default_hash  = do_quality ? "all" : hash_func_arr[0].description;
+
     // If no output file is specified, build one automatically
     if (!output_file) {
         static char default_filename[256];
 
-        const char *actual_probe = probe_str ? probe_str : probe_func_arr[0].description;
-        const char *actual_hash  = hash_str  ? hash_str  : hash_func_arr[0].description;
+        const char *actual_probe = probe_str ? probe_str : default_probe;
+        const char *actual_hash  = hash_str  ? hash_str  : default_hash;
 
         if (!generate_output_filename(mode_str,
                                       actual_probe,
@@ -691,7 +1221,9 @@ int main(int argc, char *argv[]) {
         .load_factor      = load_factor,
         .min_load_factor  = min_load_factor,
         .inactive_factor  = inactive_factor,
+        .growth_factor    = growth_factor,
         .hash_func        = hash_fn,
+        .hash_func2       = hash2_fn,
         .cmp_func         = int_cmp,
         .p                = probe_fn,
         .freekey          = free,
@@ -702,11 +1234,17 @@ int main(int argc, char *argv[]) {
     // Info message
     printf("Running benchmark:\n");
     printf("  Mode          : %s\n", mode_str);
-    printf("  Probe         : %s\n", probe_str ? probe_str : probe_func_arr[0].description);
-    printf("  Hash          : %s\n", hash_str ? hash_str : hash_func_arr[0].description);
+    printf("  Probe         : %s\n", probe_str ? probe_str : default_probe);
+    printf("  Hash          : %s\n", hash_str ? hash_str : default_hash);
+    if (hash2_str) {
+        printf("  Hash2         : %s\n", hash2_str);
+    }
     printf("  Load Factor   : %.2f\n", load_factor);
+    printf("  Growth Factor : %.2f\n", growth_factor);
     printf("  Num Tests     : %zu\n", num_tests);
     printf("  Output File   : %s\n", output_file);
+    printf("  ISA           : %s (set %s to cap it)\n",
+           ht_isa_name(ht_cpu_isa()), HT_FORCE_ISA_ENV);
 
     // Execute selected benchmarks
     if (do_insert) {
@@ -715,6 +1253,9 @@ int main(int argc, char *argv[]) {
     if (do_lookup) {
         avg_lookup_benchmark(&config, num_tests);
     }
+    if (do_quality) {
+        quality_benchmark(&config, num_tests);
+    }
     if (do_mixed) {
         mixed_benchmark(
                 &config,
@@ -8,8 +8,26 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <limits.h>     
+#include <string.h>
 #include "unity.h"
 #include "open_addressing.h"
+#include "cpu_dispatch.h"
+#include "probe_iter.h"
+
+/* from hash_func.c, basic_func.h also declares the library probe functions
+ * that the static test probes below shadow */
+uint32_t crc32_hash(void *key, size_t len);
+uint32_t crc32c_hash(void *key, size_t len);
+uint32_t wyhash_32_hash(void *key, size_t len);
+uint64_t wyhash_64_hash(void *key, size_t len);
+uint32_t murmur3_32_hash(void *key, size_t len);
+uint32_t fnv1a_hash(void *key, size_t len);
+uint32_t djb2_hash(void *key, size_t len);
+void hash_batch_murmur3_32(void **keys, const size_t *lens, size_t n, uint32_t *out);
+void hash_batch_fnv1a(void **keys, const size_t *lens, size_t n, uint32_t *out);
+/* from probe_func.c */
+uint32_t double_hash_probe_func(uint32_t k, uint32_t i, uint32_t m);
+uint32_t bucket_probe_func(uint32_t k, uint32_t i, uint32_t m);
 
 /* --------------------------------------------------------------------------
    Example Probing Method Enum
@@ -68,6 +86,7 @@ void setUp(void)
         0.0f,                /* min_load_factor -> default */
         0.0f,                /* inactive_factor -> default */
         NULL,                /* hash_func -> use default_hash_func */
+        NULL,                /* hash_func2 -> step from hash_func */
         compare_int_keys,    /* cmp_func -> compare_int_keys */
         probe_ptr,           /* probe function -> linear/quadratic */
         free,                /* freekey -> none (we don't free stack vars here) */
@@ -559,6 +578,479 @@ void test_large_mixed_insertions_deletions_lookup(void)
         }
     }
 }
+
+/* --------------------------------------------------------------------------
+   ProbingStrategyTests
+ * -------------------------------------------------------------------------- */
+
+static int free_count = 0;
+
+static void count_free(void *p) {
+    free_count++;
+    free(p);
+}
+
+/* Maps four consecutive keys to one home slot to build long clusters */
+static uint32_t cluster_hash(void *key, size_t len) {
+    (void)len;
+    return (uint32_t)(*(int *)key / 4);
+}
+
+/**
+ * @brief Removal with the default (linear) probe frees the entry at once
+ * and keeps every remaining key of the cluster reachable.
+ */
+void test_linear_remove_backward_shift(void)
+{
+    const int TOTAL_KEYS = 256;
+    HashTab *lin = init_ht(0.75f, 0.0f, 0.0f, cluster_hash, NULL, compare_int_keys,
+                           NULL, count_free, count_free);
+    TEST_ASSERT_NOT_NULL(lin);
+    free_count = 0;
+
+    for (int i = 0; i < TOTAL_KEYS; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i * 2;
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, insert_ht(lin, key, sizeof(int), value));
+    }
+
+    int removed = 0;
+    for (int i = 0; i < TOTAL_KEYS; i += 3) {
+        int temp_key = i;
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, remove_ht(lin, &temp_key, sizeof(int)));
+        removed++;
+    }
+    /* key and value freed by each removal, nothing kept as a tombstone */
+    TEST_ASSERT_EQUAL_INT(2 * removed, free_count);
+
+    for (int i = 0; i < TOTAL_KEYS; i++) {
+        int temp_key = i;
+        int index = search_ht(lin, &temp_key, sizeof(int));
+        if (i % 3 == 0) {
+            TEST_ASSERT_EQUAL_INT(HT_KEY_NOT_FOUND, index);
+        } else {
+            TEST_ASSERT_GREATER_OR_EQUAL_INT(0, index);
+            TEST_ASSERT_EQUAL_INT(i * 2, *(int *)fetch_ht(lin, (uint32_t)index));
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT(HT_SUCCESS, free_ht(lin));
+    TEST_ASSERT_EQUAL_INT(2 * TOTAL_KEYS, free_count);
+}
+
+/**
+ * @brief Quadratic probing purges tombstones in place once they outnumber
+ * the live entries, freeing them without changing the table size.
+ */
+void test_tombstone_purge_in_place(void)
+{
+    const int TOTAL_KEYS = 100;
+    const int REMOVED_KEYS = 60;
+    HashTab *quad = init_ht(0.5f, 0.01f, 0.5f, NULL, NULL, compare_int_keys,
+                            quadratic_probe_func, count_free, count_free);
+    TEST_ASSERT_NOT_NULL(quad);
+    free_count = 0;
+
+    for (int i = 0; i < TOTAL_KEYS; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i * 2;
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, insert_ht(quad, key, sizeof(int), value));
+    }
+    int size = size_ht(quad);
+
+    for (int i = 0; i < REMOVED_KEYS; i++) {
+        int temp_key = i;
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, remove_ht(quad, &temp_key, sizeof(int)));
+    }
+    /* the 51st removal drops active below half of used: the 51 tombstones
+     * are freed and the table is rehashed without changing its size */
+    TEST_ASSERT_EQUAL_INT(2 * 51, free_count);
+    TEST_ASSERT_EQUAL_INT(size, size_ht(quad));
+
+    for (int i = 0; i < TOTAL_KEYS; i++) {
+        int temp_key = i;
+        int index = search_ht(quad, &temp_key, sizeof(int));
+        if (i < REMOVED_KEYS) {
+            TEST_ASSERT_EQUAL_INT(HT_KEY_NOT_FOUND, index);
+        } else {
+            TEST_ASSERT_GREATER_OR_EQUAL_INT(0, index);
+            TEST_ASSERT_EQUAL_INT(i * 2, *(int *)fetch_ht(quad, (uint32_t)index));
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT(HT_SUCCESS, free_ht(quad));
+}
+
+/**
+ * @brief A successful search moves the entry into the first tombstone on
+ * its probe sequence.
+ */
+void test_search_moves_entry_into_tombstone(void)
+{
+    HashTab *quad = init_ht(0.25f, 0.01f, 0.01f, cluster_hash, NULL, compare_int_keys,
+                            quadratic_probe_func, free, free);
+    TEST_ASSERT_NOT_NULL(quad);
+
+    /* keys 0..2 share a hash and follow the same probe sequence */
+    for (int i = 0; i < 3; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i * 2;
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, insert_ht(quad, key, sizeof(int), value));
+    }
+    int temp_key = 0;
+    int first = search_ht(quad, &temp_key, sizeof(int));
+    TEST_ASSERT_EQUAL_INT(HT_SUCCESS, remove_ht(quad, &temp_key, sizeof(int)));
+
+    /* key 2 is pulled into the tombstone left by key 0 */
+    temp_key = 2;
+    TEST_ASSERT_EQUAL_INT(first, search_ht(quad, &temp_key, sizeof(int)));
+    TEST_ASSERT_EQUAL_INT(4, *(int *)fetch_ht(quad, (uint32_t)first));
+    temp_key = 1;
+    TEST_ASSERT_GREATER_OR_EQUAL_INT(0, search_ht(quad, &temp_key, sizeof(int)));
+    temp_key = 0;
+    TEST_ASSERT_EQUAL_INT(HT_KEY_NOT_FOUND, search_ht(quad, &temp_key, sizeof(int)));
+
+    TEST_ASSERT_EQUAL_INT(HT_SUCCESS, free_ht(quad));
+}
+
+/**
+ * @brief Double hashing with a secondary hash keeps keys whose primary
+ * hashes collide reachable through resizes, tombstones and purges.
+ */
+void test_double_hash_secondary_hash(void)
+{
+    const int TOTAL_KEYS = 256;
+    HashTab *dh = init_ht(0.5f, 0.05f, 0.5f, cluster_hash, murmur3_32_hash,
+                          compare_int_keys, double_hash_probe_func, free, free);
+    TEST_ASSERT_NOT_NULL(dh);
+
+    for (int i = 0; i < TOTAL_KEYS; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i * 2;
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, insert_ht(dh, key, sizeof(int), value));
+    }
+    for (int i = 0; i < TOTAL_KEYS; i += 3) {
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, remove_ht(dh, &i, sizeof(int)));
+    }
+    for (int i = 0; i < TOTAL_KEYS; i++) {
+        int index = search_ht(dh, &i, sizeof(int));
+        if (i % 3 == 0) {
+            TEST_ASSERT_EQUAL_INT(HT_KEY_NOT_FOUND, index);
+        } else {
+            TEST_ASSERT_TRUE(index >= 0);
+            TEST_ASSERT_EQUAL_INT(i * 2, *(int *)fetch_ht(dh, (uint32_t)index));
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(HT_SUCCESS, free_ht(dh));
+}
+
+/**
+ * @brief A 1.5x growth factor gives non power-of-2 sizes that the default
+ * and double hashing probes still cover.
+ */
+void test_growth_factor_non_power_of_two(void)
+{
+    const int TOTAL_KEYS = 2000;
+    uint32_t (*probes[])(uint32_t k, uint32_t i, uint32_t m) = {
+        NULL, double_hash_probe_func
+    };
+
+    TEST_ASSERT_EQUAL_INT(HT_INVALID_ARG, set_growth_ht(NULL, 1.5f));
+    for (int p = 0; p < 2; p++) {
+        HashTab *g = init_ht(0.75f, 0.05f, 0.5f, murmur3_32_hash,
+                             p ? wyhash_32_hash : NULL, compare_int_keys,
+                             probes[p], free, free);
+        TEST_ASSERT_NOT_NULL(g);
+        TEST_ASSERT_EQUAL_INT(HT_INVALID_ARG, set_growth_ht(g, 1.0f));
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, set_growth_ht(g, 1.5f));
+
+        for (int i = 0; i < TOTAL_KEYS; i++) {
+            int *key = malloc(sizeof(int));
+            int *value = malloc(sizeof(int));
+            *key = i;
+            *value = i * 2;
+            TEST_ASSERT_EQUAL_INT(HT_SUCCESS, insert_ht(g, key, sizeof(int), value));
+        }
+        /* 1.5x growth leaves power-of-2 sizes behind */
+        TEST_ASSERT_NOT_EQUAL(0, size_ht(g) & (size_ht(g) - 1));
+        TEST_ASSERT_TRUE(size_ht(g) * 0.75f >= TOTAL_KEYS);
+
+        for (int i = 0; i < TOTAL_KEYS; i += 3) {
+            TEST_ASSERT_EQUAL_INT(HT_SUCCESS, remove_ht(g, &i, sizeof(int)));
+        }
+        for (int i = 0; i < TOTAL_KEYS; i++) {
+            int index = search_ht(g, &i, sizeof(int));
+            if (i % 3 == 0) {
+                TEST_ASSERT_EQUAL_INT(HT_KEY_NOT_FOUND, index);
+            } else {
+                TEST_ASSERT_TRUE(index >= 0);
+                TEST_ASSERT_EQUAL_INT(i * 2, *(int *)fetch_ht(g, (uint32_t)index));
+            }
+        }
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, free_ht(g));
+    }
+}
+
+/**
+ * @brief The premix spreads a weak hash over a non power-of-2 table for
+ * every probe kind.
+ */
+void test_growth_factor_weak_hash(void)
+{
+    enum { M = 2 * 1021, N = 1500, TOTAL_KEYS = 20000 };
+    static unsigned char occupied[M];
+    const ProbeKind kinds[] = {
+        PROBE_LINEAR, PROBE_TRIANGULAR, PROBE_DOUBLE_HASH, PROBE_BUCKET
+    };
+    ProbeIter it;
+    uint32_t index, hash, probes, total, longest;
+
+    /* djb2 of small integers differs only in its low bits, the premix has
+     * to spread them over a table that is not a power of 2 */
+    for (int p = 0; p < 4; p++) {
+        memset(occupied, 0, sizeof(occupied));
+        total = 0;
+        longest = 0;
+        for (int n = 0; n < N; n++) {
+            hash = djb2_hash(&n, sizeof(int));
+            index = probe_iter_init(&it, kinds[p], NULL, hash, hash, M);
+            for (probes = 1; occupied[index] && probes <= M; probes++) {
+                index = probe_iter_next(&it);
+            }
+            TEST_ASSERT_EQUAL_UINT8(0, occupied[index]);
+            occupied[index] = 1;
+            total += probes;
+            if (probes > longest) {
+                longest = probes;
+            }
+        }
+        TEST_ASSERT_TRUE(total <= 3 * N);
+        TEST_ASSERT_TRUE(longest <= 64);
+    }
+
+    HashTab *g = init_ht(0.75f, 0.05f, 0.5f, djb2_hash, NULL, compare_int_keys,
+                         NULL, free, free);
+    TEST_ASSERT_NOT_NULL(g);
+    TEST_ASSERT_EQUAL_INT(HT_SUCCESS, set_growth_ht(g, 1.5f));
+    for (int i = 0; i < TOTAL_KEYS; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i * 2;
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, insert_ht(g, key, sizeof(int), value));
+    }
+    for (int i = 0; i < TOTAL_KEYS; i++) {
+        int index = search_ht(g, &i, sizeof(int));
+        TEST_ASSERT_TRUE(index >= 0);
+        TEST_ASSERT_EQUAL_INT(i * 2, *(int *)fetch_ht(g, (uint32_t)index));
+    }
+    TEST_ASSERT_EQUAL_INT(HT_SUCCESS, free_ht(g));
+}
+
+/**
+ * @brief Probe iterators follow the sequence of the matching probe function.
+ */
+void test_probe_iterators(void)
+{
+    enum { M = 1024 };
+    static unsigned char seen[M];
+    const uint32_t k = 0xDEADBEEFu;
+    ProbeIter it;
+    uint32_t index, i;
+
+    /* triangular probing reaches every slot of a power-of-2 table once */
+    memset(seen, 0, sizeof(seen));
+    index = probe_iter_init(&it, PROBE_TRIANGULAR, NULL, k, k, M);
+    for (i = 0; i < M; i++, index = probe_iter_next(&it)) {
+        TEST_ASSERT_EQUAL_UINT32((k + i * (i + 1) / 2) & (M - 1), index);
+        TEST_ASSERT_EQUAL_UINT8(0, seen[index]);
+        seen[index] = 1;
+    }
+
+    index = probe_iter_init(&it, PROBE_DOUBLE_HASH, NULL, k, k, M);
+    for (i = 0; i < M; i++, index = probe_iter_next(&it)) {
+        TEST_ASSERT_EQUAL_UINT32((k + i * ((k << 1) | 1)) & (M - 1), index);
+    }
+
+    /* custom probes go through the function with the step count */
+    index = probe_iter_init(&it, PROBE_CUSTOM, quadratic_probe_func, k, k, M);
+    for (i = 0; i < M; i++, index = probe_iter_next(&it)) {
+        TEST_ASSERT_EQUAL_UINT32(quadratic_probe_func(k, i, M), index);
+    }
+}
+
+/**
+ * @brief Bucket probing scans the home line first, visits every slot once
+ * and keeps keys reachable at power-of-2 and prime line counts.
+ */
+void test_bucket_probe(void)
+{
+    enum { TOTAL_KEYS = 2000 };
+    static unsigned char seen[HT_LINE_SLOTS * 1021];
+    const uint32_t sizes[] = {1024, HT_LINE_SLOTS * 1021};   /* 2^10 and a prime line count */
+    const uint32_t k = 0xDEADBEEFu;
+    ProbeIter it;
+    uint32_t index, i, m;
+
+    for (int s = 0; s < 2; s++) {
+        m = sizes[s];
+        memset(seen, 0, sizeof(seen));
+        index = probe_iter_init(&it, PROBE_BUCKET, NULL, k, k, m);
+        for (i = 0; i < m; i++, index = probe_iter_next(&it)) {
+            TEST_ASSERT_EQUAL_UINT32(bucket_probe_func(k, i, m), index);
+            TEST_ASSERT_EQUAL_UINT8(0, seen[index]);
+            seen[index] = 1;
+            /* the home slot's line is scanned before any other */
+            if (i < HT_LINE_SLOTS) {
+                TEST_ASSERT_EQUAL_UINT32(probe_home(k, m) / HT_LINE_SLOTS,
+                                         index / HT_LINE_SLOTS);
+            }
+        }
+    }
+
+    for (int g = 0; g < 2; g++) {
+        HashTab *b = init_ht(0.75f, 0.05f, 0.5f, murmur3_32_hash, NULL,
+                             compare_int_keys, bucket_probe_func, free, free);
+        TEST_ASSERT_NOT_NULL(b);
+        if (g) {
+            TEST_ASSERT_EQUAL_INT(HT_SUCCESS, set_growth_ht(b, 1.5f));
+        }
+        for (int n = 0; n < TOTAL_KEYS; n++) {
+            int *key = malloc(sizeof(int));
+            int *value = malloc(sizeof(int));
+            *key = n;
+            *value = n * 2;
+            TEST_ASSERT_EQUAL_INT(HT_SUCCESS, insert_ht(b, key, sizeof(int), value));
+        }
+        TEST_ASSERT_EQUAL_UINT32(0, size_ht(b) % HT_LINE_SLOTS);
+        for (int n = 0; n < TOTAL_KEYS; n += 3) {
+            TEST_ASSERT_EQUAL_INT(HT_SUCCESS, remove_ht(b, &n, sizeof(int)));
+        }
+        for (int n = 0; n < TOTAL_KEYS; n++) {
+            int index = search_ht(b, &n, sizeof(int));
+            if (n % 3 == 0) {
+                TEST_ASSERT_EQUAL_INT(HT_KEY_NOT_FOUND, index);
+            } else {
+                TEST_ASSERT_TRUE(index >= 0);
+                TEST_ASSERT_EQUAL_INT(n * 2, *(int *)fetch_ht(b, (uint32_t)index));
+            }
+        }
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, free_ht(b));
+    }
+}
+
+/* --------------------------------------------------------------------------
+   HashFunctionTests
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @brief CRC32 and CRC32C match their published check values.
+ */
+void test_crc_check_values(void)
+{
+    char check[] = "123456789";
+    unsigned char buf[32];
+
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc32_hash(check, 9));
+    TEST_ASSERT_EQUAL_HEX32(0xE3069283, crc32c_hash(check, 9));
+
+    /* RFC 3720 iSCSI vectors, these go through the 8-byte chunk path */
+    memset(buf, 0x00, sizeof(buf));
+    TEST_ASSERT_EQUAL_HEX32(0x8A9136AA, crc32c_hash(buf, sizeof(buf)));
+    memset(buf, 0xFF, sizeof(buf));
+    TEST_ASSERT_EQUAL_HEX32(0x62A8AB43, crc32c_hash(buf, sizeof(buf)));
+    for (int i = 0; i < 32; i++) {
+        buf[i] = (unsigned char)i;
+    }
+    TEST_ASSERT_EQUAL_HEX32(0x46DD794E, crc32c_hash(buf, sizeof(buf)));
+}
+
+/**
+ * @brief wyhash gives distinct hashes across every key length path.
+ */
+void test_wyhash_lengths(void)
+{
+    unsigned char buf[128];
+    uint64_t seen[sizeof(buf) + 1];
+
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (unsigned char)(i * 131 + 7);
+    }
+    /* every length path (0, 1-3, 4-16, 17-48, >48) gives a distinct hash,
+     * and the 32-bit variant is the folded 64-bit one */
+    for (size_t len = 0; len <= sizeof(buf); len++) {
+        uint64_t hash = wyhash_64_hash(buf, len);
+        TEST_ASSERT_EQUAL_HEX32((uint32_t)(hash ^ (hash >> 32)),
+                                wyhash_32_hash(buf, len));
+        for (size_t j = 0; j < len; j++) {
+            TEST_ASSERT_TRUE(seen[j] != hash);
+        }
+        seen[len] = hash;
+    }
+    /* the last byte of a long key reaches the result */
+    uint32_t before = wyhash_32_hash(buf, 100);
+    buf[99] ^= 1;
+    TEST_ASSERT_NOT_EQUAL(before, wyhash_32_hash(buf, 100));
+}
+
+/**
+ * @brief Batch hashing gives the same results as the scalar hashes.
+ */
+void test_batch_hash_matches_scalar(void)
+{
+    enum { NUM_KEYS = 100 };
+    unsigned char data[NUM_KEYS][24];
+    void *keys[NUM_KEYS];
+    size_t lens[NUM_KEYS];
+    uint32_t out[NUM_KEYS];
+
+    /* runs of equal lengths fill whole lane groups, the rest break them up */
+    for (int i = 0; i < NUM_KEYS; i++) {
+        for (int b = 0; b < 24; b++) {
+            data[i][b] = (unsigned char)(i * 31 + b * 7);
+        }
+        keys[i] = data[i];
+        lens[i] = i < 64 ? (size_t)(i / 32) * 9 + 3 : (size_t)(i % 24);
+    }
+
+    hash_batch_murmur3_32(keys, lens, NUM_KEYS, out);
+    for (int i = 0; i < NUM_KEYS; i++) {
+        TEST_ASSERT_EQUAL_HEX32(murmur3_32_hash(keys[i], lens[i]), out[i]);
+    }
+    hash_batch_fnv1a(keys, lens, NUM_KEYS, out);
+    for (int i = 0; i < NUM_KEYS; i++) {
+        TEST_ASSERT_EQUAL_HEX32(fnv1a_hash(keys[i], lens[i]), out[i]);
+    }
+}
+
+/**
+ * @brief Forcing an ISA level by name can only lower the detected level.
+ */
+void test_isa_force_caps_detected_level(void)
+{
+    HTIsaLevel level;
+
+    TEST_ASSERT_EQUAL_INT(0, ht_isa_from_name("avx2", &level));
+    TEST_ASSERT_EQUAL_INT(HT_ISA_AVX2, level);
+    TEST_ASSERT_EQUAL_INT(-1, ht_isa_from_name("avx3", &level));
+    TEST_ASSERT_EQUAL_STRING("sse4.2", ht_isa_name(HT_ISA_SSE42));
+
+    /* forcing only lowers the level, unknown or missing names are ignored */
+    TEST_ASSERT_EQUAL_INT(HT_ISA_SCALAR, ht_isa_cap(HT_ISA_AVX512, "scalar"));
+    TEST_ASSERT_EQUAL_INT(HT_ISA_SSE42, ht_isa_cap(HT_ISA_SSE42, "avx512"));
+    TEST_ASSERT_EQUAL_INT(HT_ISA_AVX2, ht_isa_cap(HT_ISA_AVX2, "bogus"));
+    TEST_ASSERT_EQUAL_INT(HT_ISA_AVX2, ht_isa_cap(HT_ISA_AVX2, NULL));
+    TEST_ASSERT_TRUE(ht_cpu_isa() <= ht_cpu_detect_isa());
+}
+
 /* --------------------------------------------------------------------------
    Test Runner
  * -------------------------------------------------------------------------- */
@@ -602,5 +1094,21 @@ int main(void)
     printf("\n --- Quadratic probing --- \n");
     test_probing_method(QUADRATIC);
 
+    printf("\n --- Probing strategies --- \n");
+    RUN_TEST(test_linear_remove_backward_shift);
+    RUN_TEST(test_tombstone_purge_in_place);
+    RUN_TEST(test_search_moves_entry_into_tombstone);
+    RUN_TEST(test_double_hash_secondary_hash);
+    RUN_TEST(test_growth_factor_non_power_of_two);
+    RUN_TEST(test_growth_factor_weak_hash);
+    RUN_TEST(test_probe_iterators);
+    RUN_TEST(test_bucket_probe);
+
+    printf("\n --- Hash functions --- \n");
+    RUN_TEST(test_crc_check_values);
+    RUN_TEST(test_wyhash_lengths);
+    RUN_TEST(test_batch_hash_matches_scalar);
+    RUN_TEST(test_isa_force_caps_detected_level);
+
     return UNITY_END();
 }
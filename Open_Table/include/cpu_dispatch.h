@@ -0,0 +1,118 @@
+/**
+ * @file    cpu_dispatch.h
+ * @brief   Runtime CPU feature detection for picking SIMD kernels.
+ *
+ * Binaries are built for the baseline ISA and choose their fast paths once,
+ * from constructors, by comparing ht_cpu_isa() with the level a kernel
+ * needs. Setting HT_FORCE_ISA to scalar, sse4.2, avx2 or avx512 caps the
+ * level, so every kernel can be benchmarked on one machine. A level the CPU
+ * lacks is never selected, whatever HT_FORCE_ISA says.
+ */
+
+#ifndef CPU_DISPATCH_H
+#define CPU_DISPATCH_H
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HT_X86_DISPATCH 1
+#endif
+
+/** Name of the environment variable that caps the ISA level */
+#define HT_FORCE_ISA_ENV "HT_FORCE_ISA"
+
+/* --- Data Structures ----------------------------------------------------- */
+
+/** ISA levels, each one implies the ones below it */
+typedef enum {
+    HT_ISA_SCALAR = 0,
+    HT_ISA_SSE42,
+    HT_ISA_AVX2,
+    HT_ISA_AVX512
+} HTIsaLevel;
+
+/* --- Functions ----------------------------------------------------------- */
+
+/**
+ * @brief Highest ISA level the running CPU and OS support.
+ */
+static inline HTIsaLevel ht_cpu_detect_isa(void) {
+#ifdef HT_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2")) {
+        return HT_ISA_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {return HT_ISA_AVX2;}
+    if (__builtin_cpu_supports("sse4.2")) {return HT_ISA_SSE42;}
+#endif
+    return HT_ISA_SCALAR;
+}
+
+/**
+ * @brief Parses an ISA level name as accepted by HT_FORCE_ISA.
+ *
+ * @param name Level name, e.g. "avx2".
+ * @param level Set to the parsed level on success.
+ *
+ * @return 0 on success, -1 if the name is unknown.
+ */
+static inline int ht_isa_from_name(
+        const char *name,
+        HTIsaLevel *level
+) {
+    static const struct {const char *name; HTIsaLevel level;} names[] = {
+        {"scalar", HT_ISA_SCALAR}, {"sse4.2", HT_ISA_SSE42}, {"sse42", HT_ISA_SSE42},
+        {"avx2", HT_ISA_AVX2}, {"avx512", HT_ISA_AVX512}, {"avx512f", HT_ISA_AVX512}
+    };
+
+    for (size_t i = 0; name && i < sizeof(names) / sizeof(names[0]); i++) {
+        if (strcmp(name, names[i].name) == 0) {
+            *level = names[i].level;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Name of an ISA level, for logs and benchmark output.
+ */
+static inline const char *ht_isa_name(
+        HTIsaLevel level
+) {
+    switch (level) {
+        case HT_ISA_SSE42: return "sse4.2";
+        case HT_ISA_AVX2: return "avx2";
+        case HT_ISA_AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+/**
+ * @brief Caps the detected level at a forced level name.
+ *
+ * @param detected Level the CPU supports.
+ * @param force Forced level name, NULL or unknown names leave it unchanged.
+ *
+ * @return The lower of the two levels.
+ */
+static inline HTIsaLevel ht_isa_cap(
+        HTIsaLevel detected,
+        const char *force
+) {
+    HTIsaLevel forced;
+
+    if (ht_isa_from_name(force, &forced) != 0) {return detected;}
+    return forced < detected ? forced : detected;
+}
+
+/**
+ * @brief ISA level kernels should be picked for: the detected level capped
+ *        by HT_FORCE_ISA. Call once when choosing kernels, not per operation.
+ */
+static inline HTIsaLevel ht_cpu_isa(void) {
+    return ht_isa_cap(ht_cpu_detect_isa(), getenv(HT_FORCE_ISA_ENV));
+}
+
+#endif /* CPU_DISPATCH_H */
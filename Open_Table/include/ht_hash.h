@@ -0,0 +1,245 @@
+/**
+ * @file    ht_hash.h
+ * @brief   Integer key hashes and keyed hashes shared by the table variants.
+ *
+ * Each variant is built from a single translation unit, so the functions
+ * are static inline and every table gets its own copy to point hash_func at.
+ */
+
+#ifndef HT_HASH_H
+#define HT_HASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* --- Macros -------------------------------------------------------------- */
+
+/** 2^32 / golden ratio, odd so the multiply is a bijection */
+#define HT_FIB_MUL32 0x9E3779B1u
+/** splitmix64 finalizer multipliers */
+#define HT_MIX64_MUL1 0xBF58476D1CE4E5B9ull
+#define HT_MIX64_MUL2 0x94D049BB133111EBull
+/** splitmix64 increment */
+#define HT_MIX64_GAMMA 0x9E3779B97F4A7C15ull
+
+#define HT_ROTL64(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+#define HT_SIPROUND(v0, v1, v2, v3) do { \
+    v0 += v1; v1 = HT_ROTL64(v1, 13); v1 ^= v0; v0 = HT_ROTL64(v0, 32); \
+    v2 += v3; v3 = HT_ROTL64(v3, 16); v3 ^= v2; \
+    v0 += v3; v3 = HT_ROTL64(v3, 21); v3 ^= v0; \
+    v2 += v1; v1 = HT_ROTL64(v1, 17); v1 ^= v2; v2 = HT_ROTL64(v2, 32); \
+} while (0)
+
+/* --- Data Structures ----------------------------------------------------- */
+
+/** Signature of HTConfig.hash_func */
+typedef uint32_t (*HTHashFunc)(const void *key, size_t len);
+/** Signature of HTConfig.seeded_hash_func */
+typedef uint32_t (*HTSeededHashFunc)(const void *key, size_t len, uint64_t seed);
+
+/* --- Hash Functions ------------------------------------------------------ */
+
+/**
+ * @brief Hash of a 4-byte key: Fibonacci multiply, then fold the well mixed
+ *        high half into the low bits that pick the slot.
+ *
+ * Bijective on 32-bit keys, so distinct keys never share a hash.
+ *
+ * @param key Pointer to the 4-byte key.
+ * @param len Ignored, the key is always 4 bytes.
+ *
+ * @return 32-bit hash of the key.
+ */
+static inline uint32_t int32_hash(
+        const void *key,
+        size_t len
+) {
+    uint32_t k;
+
+    (void)len;
+    memcpy(&k, key, sizeof(k));
+    k *= HT_FIB_MUL32;
+    return k ^ (k >> 16);
+}
+
+/**
+ * @brief Hash of an 8-byte key: splitmix64 finalizer folded to 32 bits.
+ *
+ * @param key Pointer to the 8-byte key.
+ * @param len Ignored, the key is always 8 bytes.
+ *
+ * @return 32-bit hash of the key.
+ */
+static inline uint32_t int64_hash(
+        const void *key,
+        size_t len
+) {
+    uint64_t k;
+
+    (void)len;
+    memcpy(&k, key, sizeof(k));
+    k = (k ^ (k >> 30)) * HT_MIX64_MUL1;
+    k = (k ^ (k >> 27)) * HT_MIX64_MUL2;
+    k ^= k >> 31;
+    return (uint32_t)(k ^ (k >> 32));
+}
+
+/**
+ * @brief Picks the integer hash for fixed 4- or 8-byte keys.
+ *
+ * @param key_len Fixed key length from HTConfig, 0 for variable length keys.
+ * @param fallback Hash used for any other key length.
+ *
+ * @return int32_hash, int64_hash or fallback.
+ */
+static inline HTHashFunc ht_hash_for_key_len(
+        size_t key_len,
+        HTHashFunc fallback
+) {
+    switch (key_len) {
+        case 4: return int32_hash;
+        case 8: return int64_hash;
+        default: return fallback;
+    }
+}
+
+/* --- Keyed Hash Functions ------------------------------------------------ */
+
+/**
+ * @brief splitmix64 finalizer, used to derive key material from a seed.
+ */
+static inline uint64_t ht_mix64(
+        uint64_t x
+) {
+    x = (x ^ (x >> 30)) * HT_MIX64_MUL1;
+    x = (x ^ (x >> 27)) * HT_MIX64_MUL2;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief SipHash-1-3 keyed hash, for keys chosen by untrusted input.
+ *
+ * The 128-bit SipHash key is the seed and its splitmix64 mix. Without the
+ * seed an attacker cannot predict which keys share a home slot.
+ *
+ * @param key Pointer to the key.
+ * @param len Length of the key in bytes.
+ * @param seed Per-table secret.
+ *
+ * @return 64-bit SipHash folded to 32 bits.
+ */
+static inline uint32_t siphash13_hash(
+        const void *key,
+        size_t len,
+        uint64_t seed
+) {
+    const unsigned char *p = (const unsigned char *)key;
+    const unsigned char *end = p + (len & ~(size_t)7);
+    uint64_t k0 = seed, k1 = ht_mix64(seed + HT_MIX64_GAMMA);
+    uint64_t v0 = k0 ^ 0x736f6d6570736575ull;
+    uint64_t v1 = k1 ^ 0x646f72616e646f6dull;
+    uint64_t v2 = k0 ^ 0x6c7967656e657261ull;
+    uint64_t v3 = k1 ^ 0x7465646279746573ull;
+    uint64_t m, b = (uint64_t)len << 56;
+    int i;
+
+    for (; p != end; p += 8) {
+        m = 0;
+        for (i = 7; i >= 0; i--) {
+            m = (m << 8) | p[i];
+        }
+        v3 ^= m;
+        HT_SIPROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+    for (i = (int)(len & 7) - 1; i >= 0; i--) {
+        b |= (uint64_t)p[i] << (8 * i);
+    }
+    v3 ^= b;
+    HT_SIPROUND(v0, v1, v2, v3);
+    v0 ^= b;
+    v2 ^= 0xff;
+    HT_SIPROUND(v0, v1, v2, v3);
+    HT_SIPROUND(v0, v1, v2, v3);
+    HT_SIPROUND(v0, v1, v2, v3);
+    m = v0 ^ v1 ^ v2 ^ v3;
+    return (uint32_t)(m ^ (m >> 32));
+}
+
+/**
+ * @brief FNV-1a started from a seed-dependent basis, with a final mix.
+ *
+ * Cheap enough for trusted keys; key sets built to collide under the plain
+ * FNV-1a default no longer collide. Use siphash13_hash for hostile input.
+ *
+ * @param key Pointer to the key.
+ * @param len Length of the key in bytes.
+ * @param seed Per-table secret.
+ *
+ * @return 32-bit hash of the key.
+ */
+static inline uint32_t fnv1a_seeded_hash(
+        const void *key,
+        size_t len,
+        uint64_t seed
+) {
+    const unsigned char *p = (const unsigned char *)key;
+    uint32_t hash = 2166136261u ^ (uint32_t)ht_mix64(seed);
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    hash ^= (uint32_t)(seed >> 32);
+    hash ^= hash >> 16;
+    hash *= HT_FIB_MUL32;
+    return hash ^ (hash >> 15);
+}
+
+/** Process-wide seed material, set by ht_seed_init() before main() runs */
+static uint64_t ht_process_seed = HT_MIX64_GAMMA;
+/** Per-call counter, advanced atomically so concurrent creates differ */
+static uint64_t ht_seed_counter = 0;
+
+/**
+ * @brief Reads /dev/urandom once per process before main() runs, falling
+ *        back to the clock when it cannot be read, so ht_random_seed never
+ *        initialises shared state lazily.
+ */
+__attribute__((constructor))
+static void ht_seed_init(
+        void
+) {
+    uint64_t seed = 0;
+    FILE *urandom = fopen("/dev/urandom", "rb");
+
+    if (urandom) {
+        if (fread(&seed, sizeof(seed), 1, urandom) != 1) {seed = 0;}
+        fclose(urandom);
+    }
+    seed ^= ht_mix64((uint64_t)time(NULL) ^ ((uint64_t)clock() << 32));
+    ht_process_seed = seed ? seed : HT_MIX64_GAMMA;
+}
+
+/**
+ * @brief Draws a non-zero per-table seed from the process seed, a counter
+ *        and the salt. Safe to call from several threads at once.
+ *
+ * @param salt Address mixed in so tables created together still differ.
+ *
+ * @return Random seed, never 0.
+ */
+static inline uint64_t ht_random_seed(
+        const void *salt
+) {
+    uint64_t count, seed;
+
+    count = __atomic_add_fetch(&ht_seed_counter, HT_MIX64_GAMMA, __ATOMIC_RELAXED);
+    seed = ht_mix64(ht_process_seed + count) ^ ht_mix64((uint64_t)(uintptr_t)salt);
+    return seed ? seed : HT_MIX64_GAMMA;
+}
+
+#endif /* HT_HASH_H */
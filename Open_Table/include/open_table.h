@@ -18,6 +18,10 @@
 #define DEFAULT_LOAD_FACTOR 0.5
 /** Default minimum load factor before attempting downsizing */
 #define DEFAULT_MIN_LOAD_FACTOR 0.25
+/** Number of PSL histogram buckets in HTStats, the last one collects the tail */
+#define HT_STATS_PSL_BUCKETS 32
+/** Default HTConfig.reseed_psl_factor, reseed past 4 * log2(capacity) */
+#define DEFAULT_RESEED_PSL_FACTOR 4
 
 /**
  * @brief Default configuration macro for convenience.
@@ -26,6 +30,11 @@
     .load_factor = 0.75f, \
     .min_load_factor = 0.25f, \
     .hash_func = NULL, \
+    .key_len = 0, \
+    .seeded_hash_func = NULL, \
+    .seed = 0, \
+    .reseed_psl_factor = DEFAULT_RESEED_PSL_FACTOR, \
+    .on_reseed = NULL, \
     .cmp_func = NULL, \
     .free_key = NULL, \
     .free_val = NULL \
@@ -65,11 +74,42 @@ typedef struct {
     float load_factor;
     float min_load_factor;
     uint32_t (*hash_func)(const void *key, size_t len);
+    size_t key_len;   /**< Fixed key size, 0 if keys vary. With no hash_func,
+                           4 and 8 select the integer hashes in ht_hash.h */
+    /** Keyed hash, used instead of hash_func when set (see ht_hash.h) */
+    uint32_t (*seeded_hash_func)(const void *key, size_t len, uint64_t seed);
+    uint64_t seed;    /**< Key for seeded_hash_func, 0 draws a random one */
+    /** Rehash with a fresh seed when an insert's PSL exceeds this times
+        log2(capacity), 0 never does. Without a seeded_hash_func the table
+        switches to siphash13_hash on the first reseed. Only open_table.c
+        reseeds, the other versions ignore this field and on_reseed */
+    uint32_t reseed_psl_factor;
+    /** Called after each reseed with the PSL that caused it, may be NULL */
+    void (*on_reseed)(const HashTab *ht, uint32_t psl);
     int (*cmp_func)(const void *a, const void *b);
     void (*free_key)(void *k);
     void (*free_val)(void *v);
 } HTConfig;
 
+/**
+ * @brief Snapshot of table statistics filled in by ht_stats().
+ *
+ * resize_count and resize_time_ns are only tracked when the table is
+ * compiled with HT_STATS defined, and read as zero otherwise.
+ */
+typedef struct {
+    uint32_t capacity;          /**< Number of slots in the table.        */
+    uint32_t active;            /**< Number of stored entries.            */
+    float load_factor;          /**< Current active / capacity ratio.     */
+    uint32_t psl_histogram[HT_STATS_PSL_BUCKETS]; /**< Entries per PSL.   */
+    double avg_psl;             /**< Mean probe sequence length.          */
+    uint32_t max_psl;           /**< Longest probe sequence length.       */
+    uint64_t resize_count;      /**< Number of resizes performed.         */
+    uint64_t resize_time_ns;    /**< Total time spent resizing (ns).      */
+    uint64_t reseed_count;      /**< Reseeds, 0 outside open_table.c.     */
+    size_t bytes_allocated;     /**< Bytes held by the table structures.  */
+} HTStats;
+
 /* --- Function Prototypes ------------------------------------------------- */
 
 /**
@@ -139,6 +179,79 @@ HTResult ht_remove(
         size_t key_len
 );
 
+/**
+ * @brief Computes the hash of a key with the table's hash function.
+ *
+ * The result can be passed to the *_hashed functions of this table, or of
+ * any other table configured with the same hash function, to avoid hashing
+ * the same key once per table. A reseed (see HTConfig.reseed_psl_factor)
+ * changes the hash function, hashes computed before it are stale.
+ *
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key to hash.
+ * @param key_len Length of the key in bytes.
+ *
+ * @return The 32-bit hash of the key, 0 if ht or key is NULL.
+ */
+uint32_t ht_hash(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+);
+
+/**
+ * @brief ht_search() with a hash precomputed by ht_hash().
+ *
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key to search for.
+ * @param key_len Length of the key in bytes.
+ * @param hash_key Hash of the key under the table's hash function.
+ *
+ * @return Pointer to the value if found, NULL if not found.
+ */
+void *ht_search_hashed(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+);
+
+/**
+ * @brief ht_insert() with a hash precomputed by ht_hash().
+ *
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key to insert.
+ * @param key_len Length of the key in bytes.
+ * @param hash_key Hash of the key under the table's hash function.
+ * @param value Pointer to the value to associate with the key.
+ *
+ * @return HT_SUCCESS on success, or an error code on failure.
+ */
+HTResult ht_insert_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key,
+        void *value
+);
+
+/**
+ * @brief ht_remove() with a hash precomputed by ht_hash().
+ *
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key to remove.
+ * @param key_len Length of the key in bytes.
+ * @param hash_key Hash of the key under the table's hash function.
+ *
+ * @return HT_SUCCESS on success, or an error code on failure.
+ */
+HTResult ht_remove_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+);
+
 /**
  * @brief Prints the contents of the hash table using a custom formatter.
  *
@@ -162,4 +275,34 @@ uint32_t ht_capacity(
         const HashTab *ht
 );
 
+/**
+ * @brief Returns the longest probe sequence length (PSL) in the table.
+ *
+ * Searches and removals never probe past this distance from a key's home
+ * slot. The value is exact after a resize and an upper bound after removals.
+ *
+ * @param ht Pointer to the hash table.
+ *
+ * @return Maximum PSL of any entry, or 0 if ht is NULL.
+ */
+uint32_t ht_max_psl(
+        const HashTab *ht
+);
+
+/**
+ * @brief Collects a statistics snapshot of the hash table.
+ *
+ * The PSL histogram, average and maximum are computed by scanning the
+ * table, so the call costs O(capacity) and nothing on the hot path.
+ *
+ * @param ht Pointer to the hash table.
+ * @param out Pointer to the statistics structure to fill.
+ *
+ * @return HT_SUCCESS on success, HT_INVALID_ARG if ht or out is NULL.
+ */
+HTResult ht_stats(
+        const HashTab *ht,
+        HTStats *out
+);
+
 #endif /* OPEN_TABLE_H */
@@ -0,0 +1,53 @@
+#ifndef STATS_HASHTAB_H
+#define STATS_HASHTAB_H
+
+#include <stdint.h>
+
+#ifdef HT_STATS
+
+#include <time.h>
+
+/**
+ * @brief Reads a monotonic clock in nanoseconds.
+ *
+ * @return Current time in nanoseconds.
+ */
+static inline uint64_t stats_now_ns(
+		void
+) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Counter fields to embed in a table container */
+#define STATS_fields \
+    uint64_t resize_count;   /* Number of completed resizes              */ \
+    uint64_t resize_time_ns; /* Total time spent in resize()             */
+
+#define STATS_init(ht) \
+    do { (ht)->resize_count = 0; (ht)->resize_time_ns = 0; } while (0)
+#define STATS_timer(t)      uint64_t t = stats_now_ns()
+#define STATS_resize(ht, t) \
+    do { \
+        (ht)->resize_count++; \
+        (ht)->resize_time_ns += stats_now_ns() - (t); \
+    } while (0)
+#define STATS_export(ht, out) \
+    do { \
+        (out)->resize_count = (ht)->resize_count; \
+        (out)->resize_time_ns = (ht)->resize_time_ns; \
+    } while (0)
+
+#else
+
+#define STATS_fields
+#define STATS_init(ht)        ((void)0)
+#define STATS_timer(t)        ((void)0)
+#define STATS_resize(ht, t)   ((void)0)
+#define STATS_export(ht, out) \
+    do { (out)->resize_count = 0; (out)->resize_time_ns = 0; } while (0)
+
+#endif /* HT_STATS */
+
+#endif /* STATS_HASHTAB_H */
@@ -6,11 +6,15 @@
  * @date    2024-10-23
  */
 
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include "open_table.h"
+#include "ht_hash.h"
 #include "debug_hashtab.h"
+#include "stats_hashtab.h"
 
 #define PRINT_BUFFER_SIZE 1024
 
@@ -54,6 +58,7 @@
 struct htentry {
     uint32_t hash_key;   /* Cached hash code for quicker comparison      */
     uint32_t psl;        /* Probe sequence length                        */
+    size_t key_len;      /* Key length, to rehash under a new seed       */
     void *key;           /* Pointer to key data                          */
     void *value;         /* Pointer to value data                        */
 };
@@ -63,19 +68,32 @@ struct hashtab {
     HTentry *table;      /* Underlying array of entries (slots)          */
     uint32_t size;       /* Current size (capacity) of the table         */
     uint32_t active;     /* Number of non-empty entries (active)         */
+    uint32_t max_psl;    /* Longest probe sequence length in the table   */
+    uint32_t reseed_psl; /* Insert PSL that triggers a reseed, see      *
+                          * update_reseed_psl()                         */
+    uint32_t reseed_psl_factor;
+    uint32_t reseeds;    /* Number of reseeds so far                     */
 
     float load_factor;       /* Max load factor before resizing          */
     float min_load_factor;   /* Min load factor to consider downsizing    */
 
     uint32_t (*hash_func)(const void *key, size_t len);
+    uint32_t (*seeded_hash_func)(const void *key, size_t len, uint64_t seed);
+    uint64_t seed;
+    void (*on_reseed)(const HashTab *ht, uint32_t psl);
 	int (*cmp_func)(const void *a, const void *b);
 
     void (*free_key)(void *k);
     void (*free_val)(void *v);
+
+    STATS_fields
 };
 
 /* --- function prototypes -------------------------------------------------- */
 
+static inline uint32_t compute_hash(
+        const HashTab *ht, const void *key, size_t len
+);
 static uint32_t default_hash_func(
         const void *key, size_t len
 );
@@ -84,7 +102,7 @@ static int default_cmp_func(
 );
 
 static HTResult insert_entry(
-        HashTab *ht, uint32_t hash_key, void *key, void *value
+        HashTab *ht, uint32_t hash_key, void *key, size_t key_len, void *value
 );
 static void rehash_entries(
         HashTab *ht, HTentry *old_table, uint32_t old_size
@@ -101,6 +119,12 @@ static void remove_table_update(
 static HTResult resize(
         HashTab *ht, uint32_t new_size
 );
+static HTResult reseed(
+        HashTab *ht, uint32_t psl
+);
+static void update_reseed_psl(
+        HashTab *ht
+);
 static void free_entry(
         HashTab *ht, HTentry *entry
 );
@@ -134,13 +158,25 @@ HashTab *ht_create(
     /* Initialize load tracking variables */
     ht->size = 2;
     ht->active = 0;
+    ht->max_psl = 0;
+    ht->reseeds = 0;
+    STATS_init(ht);
     
     /* Initialize load factors with defaults if zero */
     ht->load_factor = config->load_factor;
     ht->min_load_factor = config->min_load_factor;
 
     /* Initialize function ptrs withe defaults if NULL */
-    ht->hash_func = config->hash_func ? config->hash_func : default_hash_func;
+    ht->hash_func = config->hash_func ? config->hash_func :
+        ht_hash_for_key_len(config->key_len, default_hash_func);
+    ht->seeded_hash_func = config->seeded_hash_func;
+    ht->seed = config->seed;
+    if (ht->seeded_hash_func && ht->seed == 0) {
+        ht->seed = ht_random_seed(ht);
+    }
+    ht->reseed_psl_factor = config->reseed_psl_factor;
+    ht->on_reseed = config->on_reseed;
+    update_reseed_psl(ht);
     ht->cmp_func = config->cmp_func ? config->cmp_func : default_cmp_func;
     ht->free_key = config->free_key ? config->free_key : NULL;
     ht->free_val = config->free_val ? config->free_val : NULL;
@@ -153,22 +189,46 @@ HashTab *ht_create(
 	return ht;
 }
 
-void *ht_search(
+uint32_t ht_hash(
         const HashTab *ht,
         const void *key,
         size_t key_len
 ) {
-    uint32_t i, hash_key, index;
-    HTentry *entry;
+    CHECK_NULL(ht, "ht_hash: HashTab NULL", 0);
+    CHECK_NULL(key, "ht_hash: Key NULL", 0);
+
+    return compute_hash(ht, key, key_len);
+}
 
-    DBG_info("ht_search");
+void *ht_search(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
     CHECK_NULL(ht,"ht_search: HashTab NULL", NULL);
     CHECK_NULL(key, "HT_search: Key NULL", NULL);
     CHECK_NONZERO(key_len, "ht_search: Zero key length", NULL);
 
-    hash_key = ht->hash_func(key, key_len);
+    return ht_search_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
 
-    for (i = 0; i < ht->size; i++) {
+void *ht_search_hashed(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    uint32_t i, index;
+    HTentry *entry;
+
+    DBG_info("ht_search_hashed");
+    CHECK_NULL(ht,"ht_search_hashed: HashTab NULL", NULL);
+    CHECK_NULL(key, "ht_search_hashed: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search_hashed: Zero key length", NULL);
+
+
+    /* no entry is further than max_psl from its home slot */
+    for (i = 0; i <= ht->max_psl; i++) {
         /* calculate index to probe */
         index = probe_func(hash_key, i, ht->size);
         entry = &ht->table[index];
@@ -187,7 +247,7 @@ void *ht_search(
         if (entry->psl < i) {return NULL;}
     }
 
-    DBG_info("ht_search: Key not found");
+    DBG_info("ht_search_hashed: Key not found");
     return NULL;
     
 }
@@ -198,14 +258,34 @@ HTResult ht_insert(
         size_t key_len,
         void *value
 ) {
-    uint32_t hash_key;
-    HTResult result;
-
     CHECK_NULL(ht, "ht_insert: HashTab NULL", HT_INVALID_ARG);
     CHECK_NULL(key, "ht_insert: Key NULL", HT_INVALID_ARG);
     CHECK_NONZERO(key_len, "ht_insert: Zero key length", HT_INVALID_ARG);
 
-    if (ht_search(ht, key, key_len)) {
+    return ht_insert_hashed(
+        ht,
+        key,
+        key_len,
+        compute_hash(ht, key, key_len),
+        value
+    );
+}
+
+HTResult ht_insert_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key,
+        void *value
+) {
+    HTResult result;
+    uint32_t old_max_psl;
+
+    CHECK_NULL(ht, "ht_insert_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert_hashed: Zero key length", HT_INVALID_ARG);
+
+    if (ht_search_hashed(ht, key, key_len, hash_key)) {
         return HT_KEY_EXISTS;// replace with CHECK_NULL if possible
     }
 
@@ -216,13 +296,21 @@ HTResult ht_insert(
         if (result != HT_SUCCESS) {return result;}
     }
 
-    hash_key = ht->hash_func(key, key_len);
-    return insert_entry(
+    old_max_psl = ht->max_psl;
+    result = insert_entry(
         ht,
         hash_key,
         (void *)key,
+        key_len,
         value
     );
+    /* this insert built a pathologically long probe sequence, the key is
+     * stored either way, so a failed reseed only keeps the long sequence */
+    if (result == HT_SUCCESS && ht->max_psl > ht->reseed_psl &&
+        ht->max_psl > old_max_psl) {
+        (void)reseed(ht, ht->max_psl);
+    }
+    return result;
 }
 
 /**
@@ -239,7 +327,19 @@ HTResult ht_remove(HashTab *ht, const void *key, size_t key_len) {
     CHECK_NULL(key, "ht_remove: Key NULL", HT_INVALID_ARG);
     CHECK_NONZERO(key_len, "ht_remove: Zero key length", HT_INVALID_ARG);
 
-    uint32_t hash_key = ht->hash_func(key, key_len);
+    return ht_remove_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+HTResult ht_remove_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    CHECK_NULL(ht, "ht_remove_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove_hashed: Zero key length", HT_INVALID_ARG);
+
     return remove_entry(ht, hash_key, key);
 }
 
@@ -305,6 +405,45 @@ uint32_t ht_capacity(
     return ht->size;
 }
 
+uint32_t ht_max_psl(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_max_psl: HashTab NULL", 0);
+    return ht->max_psl;
+}
+
+HTResult ht_stats(
+        const HashTab *ht,
+        HTStats *out
+) {
+    uint32_t i, psl;
+    uint64_t psl_sum;
+
+    CHECK_NULL(ht, "ht_stats: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(out, "ht_stats: HTStats NULL", HT_INVALID_ARG);
+
+    memset(out, 0, sizeof(*out));
+    out->capacity = ht->size;
+    out->active = ht->active;
+    out->load_factor = (float)ht->active / (float)ht->size;
+
+    psl_sum = 0;
+    for (i = 0; i < ht->size; i++) {
+        if (ht->table[i].key == NULL) {continue;}
+        psl = ht->table[i].psl;
+        psl_sum += psl;
+        if (psl > out->max_psl) {out->max_psl = psl;}
+        if (psl >= HT_STATS_PSL_BUCKETS) {psl = HT_STATS_PSL_BUCKETS - 1;}
+        out->psl_histogram[psl]++;
+    }
+    out->avg_psl = ht->active ? (double)psl_sum / ht->active : 0.0;
+    out->reseed_count = ht->reseeds;
+    out->bytes_allocated = sizeof(HashTab) + (size_t)ht->size * sizeof(HTentry);
+    STATS_export(ht, out);
+
+    return HT_SUCCESS;
+}
+
 /* --- utility functions ---------------------------------------------------- */
 
 /**
@@ -312,6 +451,7 @@ uint32_t ht_capacity(
  * @param ht Pointer to the hash table.
  * @param hash_key Precomputed hash value of the key.
  * @param key Pointer to the key data.
+ * @param key_len Length of the key in bytes.
  * @param value Pointer to the value data.
  * @return HT_SUCCESS on success, HT_INVALID_STATE if table is full.
  */
@@ -319,6 +459,7 @@ static HTResult insert_entry(
         HashTab *ht,
         uint32_t hash_key,
         void *key,
+        size_t key_len,
         void *value
 ) {
     uint32_t i, index;
@@ -327,6 +468,7 @@ static HTResult insert_entry(
     HTentry  new_entry = {
         .hash_key = hash_key,
         .psl = 0,
+        .key_len = key_len,
         .key = key,
         .value = value
     };
@@ -338,10 +480,12 @@ static HTResult insert_entry(
         if (entry->key == NULL) {
             *entry = new_entry;
             ht->active++;
+            if (new_entry.psl > ht->max_psl) {ht->max_psl = new_entry.psl;}
             return HT_SUCCESS;
         }
         /* compare probe length */
         if (new_entry.psl > entry->psl) {
+            if (new_entry.psl > ht->max_psl) {ht->max_psl = new_entry.psl;}
             /* swap "poorer" (further element steals the spot. */
             temp = *entry;
             *entry = new_entry;
@@ -373,6 +517,7 @@ static void rehash_entries(
                 ht,
                 old_table[i].hash_key,
                 old_table[i].key,
+                old_table[i].key_len,
                 old_table[i].value
             );
         }
@@ -393,7 +538,7 @@ static HTResult remove_entry(
         const void *key
 ) {
     uint32_t probe_count;
-    for (probe_count = 0; probe_count < ht->size; probe_count++) {
+    for (probe_count = 0; probe_count <= ht->max_psl; probe_count++) {
         uint32_t current_index = probe_func(hash_key, probe_count, ht->size);
         HTentry *current_entry = &ht->table[current_index];
 
@@ -472,6 +617,8 @@ static HTResult resize(
     HTResult result;
     uint32_t old_size;
 
+    STATS_timer(start);
+
     old_size = ht->size;
     old_table = ht->table;
 
@@ -484,12 +631,81 @@ static HTResult resize(
     ht->table = new_table;
     ht->size = new_size;
     ht->active = 0;
+    ht->max_psl = 0;
 
     rehash_entries(ht, old_table, old_size);
     free(old_table);// no good dangling pointers
+    update_reseed_psl(ht);
+    STATS_resize(ht, start);
     return HT_SUCCESS;
 }
 
+/**
+ * @brief Rehashes every entry at the current capacity under a fresh seed.
+ *
+ * Long probe sequences from an unlucky key set or a weak hash are broken
+ * up without growing the table. A table without a seeded hash switches to
+ * siphash13_hash. If the new seed does not bring the longest PSL back under
+ * the threshold the load, not the keys, is to blame, and reseeding stays
+ * off until the next resize.
+ *
+ * @param ht Pointer to the hash table.
+ * @param psl The PSL that triggered the reseed, passed to on_reseed.
+ * @return HT_SUCCESS, or HT_MEM_ERROR with the table unchanged.
+ */
+static HTResult reseed(
+        HashTab *ht,
+        uint32_t psl
+) {
+    HTentry *old_table, *new_table;
+    uint64_t old_seed;
+    uint32_t i;
+
+    new_table = (HTentry *)calloc(ht->size, sizeof(HTentry));
+    CHECK_NULL(new_table, "Reseed allocation failed", HT_MEM_ERROR);
+
+    if (!ht->seeded_hash_func) {ht->seeded_hash_func = siphash13_hash;}
+    old_seed = ht->seed;
+    do {
+        ht->seed = ht_random_seed(new_table);
+    } while (ht->seed == old_seed);
+
+    old_table = ht->table;
+    for (i = 0; i < ht->size; i++) {
+        if (old_table[i].key != NULL) {
+            old_table[i].hash_key = compute_hash(ht, old_table[i].key,
+                                                 old_table[i].key_len);
+        }
+    }
+    ht->table = new_table;
+    ht->active = 0;
+    ht->max_psl = 0;
+    rehash_entries(ht, old_table, ht->size);
+    free(old_table);
+
+    ht->reseeds++;
+    if (ht->max_psl > ht->reseed_psl) {ht->reseed_psl = UINT32_MAX;}
+    if (ht->on_reseed) {ht->on_reseed(ht, psl);}
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Sets the reseed threshold to reseed_psl_factor * log2(size).
+ * @param ht Pointer to the hash table.
+ */
+static void update_reseed_psl(
+        HashTab *ht
+) {
+    uint32_t log2_size = 0;
+
+    if (ht->reseed_psl_factor == 0) {
+        ht->reseed_psl = UINT32_MAX;
+        return;
+    }
+    while ((ht->size >> log2_size) > 1) {log2_size++;}
+    ht->reseed_psl = ht->reseed_psl_factor * log2_size;
+}
+
 /**
  * @brief Frees the memory associated with a hash table entry.
  * @param ht Pointer to the hash table.
@@ -526,6 +742,24 @@ static inline uint32_t probe_func(
 
 /* --- default functions ---------------------------------------------------- */
 
+/**
+ * @brief Hashes a key with the keyed hash when one is configured.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static inline uint32_t compute_hash(
+    const HashTab *ht,
+    const void *key,
+    size_t len
+) {
+    if (ht->seeded_hash_func) {
+        return ht->seeded_hash_func(key, len, ht->seed);
+    }
+    return ht->hash_func(key, len);
+}
+
 /**
  * @brief Computes a default hash value for a key using the FNV-1a algorithm.
  * @param key Pointer to the key data.
@@ -6,13 +6,27 @@
  * @date    2025-3-26
  */
 
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include "open_table.h"
+#include "ht_hash.h"
+#include "cpu_dispatch.h"
 #include "debug_hashtab.h"
+#include "stats_hashtab.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HT_AVX2_KERNEL 1
+#endif
 
 #define PRINT_BUFFER_SIZE 1024
+/** Number of slots compared per SIMD block */
+#define SIMD_LANES 8
+/** Alignment of the hash_keys and psls arrays */
+#define CACHE_LINE_SIZE 64
 
 #define SAFETY_CHECKS_ENABLED 1
 
@@ -60,19 +74,27 @@ struct hashtab {
 
     uint32_t size;       /* Current size (capacity) of the table           */
     uint32_t active;     /* Number of non-empty entries (active)           */
+    uint32_t max_psl;    /* Longest probe sequence length in the table     */
 
     float load_factor;       /* Max load factor before resizing            */
     float min_load_factor;   /* Min load factor to consider downsizing     */
 
     uint32_t (*hash_func)(const void *key, size_t len);
+    uint32_t (*seeded_hash_func)(const void *key, size_t len, uint64_t seed);
+    uint64_t seed;
 	int (*cmp_func)(const void *a, const void *b);
 
     void (*free_key)(void *k);
     void (*free_val)(void *v);
+
+    STATS_fields
 };
 
 /* --- function prototypes -------------------------------------------------- */
 
+static inline uint32_t compute_hash(
+        const HashTab *ht, const void *key, size_t len
+);
 static uint32_t default_hash_func(
         const void *key, size_t len
 );
@@ -90,8 +112,10 @@ static HTResult remove_entry(
         HashTab *ht, uint32_t hash_key, const void *key
 );
 static void shift_entries_backward(
-        HashTab *ht, uint32_t current_index, uint32_t hash_key,
-        uint32_t *probe_count
+        HashTab *ht, uint32_t current_index
+);
+static inline void move_slots_back(
+        HashTab *ht, uint32_t dst, uint32_t count
 );
 static void remove_table_update(
         HashTab *ht
@@ -113,9 +137,28 @@ static inline void set_entry(
 static inline void clear_entry(
     HashTab *ht, uint32_t index
 );
+static uint32_t *alloc_aligned_u32(
+        uint32_t size
+);
 static inline uint32_t probe_func(
         uint32_t k, uint32_t i, uint32_t m
 );
+static int32_t find_index_scalar(
+        const HashTab *ht, uint32_t hash_key, const void *key
+);
+#ifdef HT_AVX2_KERNEL
+static int32_t find_index_avx2(
+        const HashTab *ht, uint32_t hash_key, const void *key
+);
+#endif
+static void init_find_index(
+        void
+);
+
+/* Search kernel, selected for the running CPU by init_find_index() */
+static int32_t (*find_index)(
+        const HashTab *ht, uint32_t hash_key, const void *key
+) = find_index_scalar;
 
 static inline HTResult validate_load_factors(
         float load_factor, float min_load_factor
@@ -143,20 +186,28 @@ HashTab *ht_create(
     /* Initialize load tracking variables */
     ht->size = 2;
     ht->active = 0;
+    ht->max_psl = 0;
+    STATS_init(ht);
     
     /* Initialize load factors with defaults if zero */
     ht->load_factor = config->load_factor;
     ht->min_load_factor = config->min_load_factor;
 
     /* Initialize function ptrs withe defaults if NULL */
-    ht->hash_func = config->hash_func ? config->hash_func : default_hash_func;
+    ht->hash_func = config->hash_func ? config->hash_func :
+        ht_hash_for_key_len(config->key_len, default_hash_func);
+    ht->seeded_hash_func = config->seeded_hash_func;
+    ht->seed = config->seed;
+    if (ht->seeded_hash_func && ht->seed == 0) {
+        ht->seed = ht_random_seed(ht);
+    }
     ht->cmp_func = config->cmp_func ? config->cmp_func : default_cmp_func;
     ht->free_key = config->free_key ? config->free_key : NULL;
     ht->free_val = config->free_val ? config->free_val : NULL;
 
     /* Initialize structure of arrays for table entries */
-    ht->hash_keys = (uint32_t *)calloc(ht->size, sizeof(uint32_t));
-    ht->psls = (uint32_t *)calloc(ht->size, sizeof(uint32_t));
+    ht->hash_keys = alloc_aligned_u32(ht->size);
+    ht->psls = alloc_aligned_u32(ht->size);
     ht->keys = (void **)calloc(ht->size, sizeof(void *));
     ht->values = (void **)calloc(ht->size, sizeof(void *));
     CHECK_NULL(ht->hash_keys, "Hash keys allocation failed", NULL);
@@ -169,40 +220,46 @@ HashTab *ht_create(
 	return ht;
 }
 
-void *ht_search(
+uint32_t ht_hash(
         const HashTab *ht,
         const void *key,
         size_t key_len
 ) {
-    uint32_t i, hash_key, index;
+    CHECK_NULL(ht, "ht_hash: HashTab NULL", 0);
+    CHECK_NULL(key, "ht_hash: Key NULL", 0);
 
-    DBG_info("ht_search");
+    return compute_hash(ht, key, key_len);
+}
+
+void *ht_search(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
     CHECK_NULL(ht,"ht_search: HashTab NULL", NULL);
     CHECK_NULL(key, "HT_search: Key NULL", NULL);
     CHECK_NONZERO(key_len, "ht_search: Zero key length", NULL);
 
-    hash_key = ht->hash_func(key, key_len);
+    return ht_search_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
 
-    for (i = 0; i < ht->size; i++) {
-        /* calculate index to probe */
-        index = probe_func(hash_key, i, ht->size);
+void *ht_search_hashed(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    int32_t index;
 
-        /* empty bucket key not in table */
+    DBG_info("ht_search_hashed");
+    CHECK_NULL(ht,"ht_search_hashed: HashTab NULL", NULL);
+    CHECK_NULL(key, "ht_search_hashed: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search_hashed: Zero key length", NULL);
 
-        if (ht->keys[index] == NULL) {return NULL;}
-        if (
-            ht->hash_keys[index] == hash_key &&
-            ht->cmp_func(ht->keys[index], key) == 0
-        ) {
-            /* key found return */
-            return ht->values[index];
-        }
-        /* if the current entries psl is less the i(probe length) ,the entry
-         * would have been swapped earlier if if was present */
-        if (ht->psls[index] < i) {return NULL;}
-    }
+    index = find_index(ht, hash_key, key);
+    if (index >= 0) {return ht->values[index];}
 
-    DBG_info("ht_search: Key not found");
+    DBG_info("ht_search_hashed: Key not found");
     return NULL;
     
 }
@@ -213,14 +270,33 @@ HTResult ht_insert(
         size_t key_len,
         void *value
 ) {
-    uint32_t hash_key;
-    HTResult result;
-
     CHECK_NULL(ht, "ht_insert: HashTab NULL", HT_INVALID_ARG);
     CHECK_NULL(key, "ht_insert: Key NULL", HT_INVALID_ARG);
     CHECK_NONZERO(key_len, "ht_insert: Zero key length", HT_INVALID_ARG);
 
-    if (ht_search(ht, key, key_len)) {
+    return ht_insert_hashed(
+        ht,
+        key,
+        key_len,
+        compute_hash(ht, key, key_len),
+        value
+    );
+}
+
+HTResult ht_insert_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key,
+        void *value
+) {
+    HTResult result;
+
+    CHECK_NULL(ht, "ht_insert_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert_hashed: Zero key length", HT_INVALID_ARG);
+
+    if (ht_search_hashed(ht, key, key_len, hash_key)) {
         return HT_KEY_EXISTS;// replace with CHECK_NULL if possible
     }
 
@@ -231,7 +307,6 @@ HTResult ht_insert(
         if (result != HT_SUCCESS) {return result;}
     }
 
-    hash_key = ht->hash_func(key, key_len);
     return insert_entry(
         ht,
         hash_key,
@@ -254,7 +329,19 @@ HTResult ht_remove(HashTab *ht, const void *key, size_t key_len) {
     CHECK_NULL(key, "ht_remove: Key NULL", HT_INVALID_ARG);
     CHECK_NONZERO(key_len, "ht_remove: Zero key length", HT_INVALID_ARG);
 
-    uint32_t hash_key = ht->hash_func(key, key_len);
+    return ht_remove_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+HTResult ht_remove_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    CHECK_NULL(ht, "ht_remove_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove_hashed: Zero key length", HT_INVALID_ARG);
+
     return remove_entry(ht, hash_key, key);
 }
 
@@ -318,6 +405,45 @@ uint32_t ht_capacity(
     return ht->size;
 }
 
+uint32_t ht_max_psl(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_max_psl: HashTab NULL", 0);
+    return ht->max_psl;
+}
+
+HTResult ht_stats(
+        const HashTab *ht,
+        HTStats *out
+) {
+    uint32_t i, psl;
+    uint64_t psl_sum;
+
+    CHECK_NULL(ht, "ht_stats: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(out, "ht_stats: HTStats NULL", HT_INVALID_ARG);
+
+    memset(out, 0, sizeof(*out));
+    out->capacity = ht->size;
+    out->active = ht->active;
+    out->load_factor = (float)ht->active / (float)ht->size;
+
+    psl_sum = 0;
+    for (i = 0; i < ht->size; i++) {
+        if (ht->keys[i] == NULL) {continue;}
+        psl = ht->psls[i];
+        psl_sum += psl;
+        if (psl > out->max_psl) {out->max_psl = psl;}
+        if (psl >= HT_STATS_PSL_BUCKETS) {psl = HT_STATS_PSL_BUCKETS - 1;}
+        out->psl_histogram[psl]++;
+    }
+    out->avg_psl = ht->active ? (double)psl_sum / ht->active : 0.0;
+    out->bytes_allocated = sizeof(HashTab) + (size_t)ht->size *
+        (2 * sizeof(uint32_t) + 2 * sizeof(void *));
+    STATS_export(ht, out);
+
+    return HT_SUCCESS;
+}
+
 /* --- utility functions ---------------------------------------------------- */
 
 /**
@@ -341,7 +467,8 @@ static HTResult insert_entry(
     psl = 0;
 
     while (i < ht->size) {
-        index = probe_func(hash_key, i, ht->size);
+        /* probe relative to the home slot of the entry currently carried */
+        index = probe_func(hash_key, psl, ht->size);
         /* empty buckect found */
         if (ht->keys[index] == NULL) {
             set_entry(
@@ -353,10 +480,12 @@ static HTResult insert_entry(
                 value
             );
             ht->active++;
+            if (psl > ht->max_psl) {ht->max_psl = psl;}
             return HT_SUCCESS;
         }
         /* compare probe length */
         if (psl > ht->psls[index]) {
+            if (psl > ht->max_psl) {ht->max_psl = psl;}
             /* swap "poorer" (further element steals the spot.) */
             get_entry(
                 ht,
@@ -426,61 +555,83 @@ static HTResult remove_entry(
         uint32_t hash_key,
         const void *key
 ) {
-    uint32_t probe_count, current_index;
-    for (probe_count = 0; probe_count < ht->size; probe_count++) {
-        current_index = probe_func(hash_key, probe_count, ht->size);
-
-        if (ht->keys[current_index] == NULL) {
-            return HT_KEY_NOT_FOUND;
-        }
-
-        if (
-            ht->hash_keys[current_index] == hash_key &&
-            ht->cmp_func(ht->keys[current_index], key) == 0
-        ) {
-            free_entry(ht, current_index);
-            shift_entries_backward(ht, current_index, hash_key, &probe_count);
-            remove_table_update(ht);
-            return HT_SUCCESS;
-        }
+    int32_t current_index = find_index(ht, hash_key, key);
+    if (current_index < 0) {return HT_KEY_NOT_FOUND;}
 
-        if (ht->psls[current_index] < probe_count) {
-            return HT_KEY_NOT_FOUND;
-        }
-    }
-    return HT_KEY_NOT_FOUND;
+    free_entry(ht, (uint32_t)current_index);
+    shift_entries_backward(ht, (uint32_t)current_index);
+    remove_table_update(ht);
+    return HT_SUCCESS;
 }
 
 /**
  * @brief Shifts subsequent entries backward to fill the gap after removal.
+ *
+ * The run of entries that can move back (occupied with psl > 0) is measured
+ * first and then moved with one memmove per array, split in two pieces when
+ * the run wraps around the end of the table.
+ *
  * @param ht Pointer to the hash table.
- * @param current_index Index of the removed entry.
- * @param hash_key Hash key for probing.
- * @param probe_count Pointer to the current probe iteration (updated in-place).
+ * @param current_index Index of the removed (already cleared) entry.
  */
 static void shift_entries_backward(
         HashTab *ht,
-        uint32_t current_index,
-        uint32_t hash_key,
-        uint32_t *probe_count
+        uint32_t current_index
 ) {
-    uint32_t next_index = probe_func(hash_key, ++(*probe_count), ht->size);
+    uint32_t run, tail, next_index, mask;
 
+    mask = ht->size - 1;
+    run = 0;
+    next_index = (current_index + 1) & mask;
     while (ht->keys[next_index] != NULL && ht->psls[next_index] > 0) {
-        /* Move back and adjust probe sequence length */
+        run++;
+        next_index = (next_index + 1) & mask;
+    }
+    if (run == 0) {return;}
+
+    /* slots between the gap and the end of the arrays */
+    tail = ht->size - 1 - current_index;
+    if (run <= tail) {
+        move_slots_back(ht, current_index, run);
+    } else {
+        move_slots_back(ht, current_index, tail);
+        /* slot 0 wraps around into the last slot */
         set_entry(
             ht,
-            current_index,
-            ht->hash_keys[next_index],
-            ht->psls[next_index] - 1,
-            ht->keys[next_index],
-            ht->values[next_index]
+            ht->size - 1,
+            ht->hash_keys[0],
+            ht->psls[0] - 1,
+            ht->keys[0],
+            ht->values[0]
         );
-        current_index = next_index;
-        next_index = probe_func(hash_key, ++(*probe_count), ht->size);
+        move_slots_back(ht, 0, run - tail - 1);
     }
 
-    clear_entry(ht, current_index);  /* Mark last shifted slot as empty */
+    clear_entry(ht, (current_index + run) & mask);  /* Mark last shifted slot as empty */
+}
+
+/**
+ * @brief Moves count slots starting at dst + 1 back by one slot.
+ * @param ht Pointer to the hash table.
+ * @param dst Index the first moved slot is written to.
+ * @param count Number of slots to move, dst + count must be < ht->size.
+ */
+static inline void move_slots_back(
+        HashTab *ht,
+        uint32_t dst,
+        uint32_t count
+) {
+    uint32_t i;
+
+    if (count == 0) {return;}
+    memmove(&ht->hash_keys[dst], &ht->hash_keys[dst + 1], count * sizeof(uint32_t));
+    memmove(&ht->psls[dst], &ht->psls[dst + 1], count * sizeof(uint32_t));
+    memmove(&ht->keys[dst], &ht->keys[dst + 1], count * sizeof(void *));
+    memmove(&ht->values[dst], &ht->values[dst + 1], count * sizeof(void *));
+    /* contiguous decrement, vectorized by the compiler */
+    for (i = dst; i < dst + count; i++) {
+        ht->psls[i]--;
+    }
 }
 
 /**
@@ -513,12 +664,13 @@ static HTResult resize(
     void **old_values = ht->values;
     uint32_t old_size = ht->size;
     HTResult result;
+    STATS_timer(start);
 
     result = validate_size(ht->size, new_size);
     if (result != HT_SUCCESS) return result;
 
-    ht->hash_keys = (uint32_t *)calloc(new_size, sizeof(uint32_t));
-    ht->psls = (uint32_t *)calloc(new_size, sizeof(uint32_t));
+    ht->hash_keys = alloc_aligned_u32(new_size);
+    ht->psls = alloc_aligned_u32(new_size);
     ht->keys = (void **)calloc(new_size, sizeof(void *));
     ht->values = (void **)calloc(new_size, sizeof(void *));
     if (!ht->hash_keys || !ht->psls || !ht->keys || !ht->values) {
@@ -535,12 +687,14 @@ static HTResult resize(
 
     ht->size = new_size;
     ht->active = 0;
+    ht->max_psl = 0;
 
     rehash_entries(ht, old_hash_keys, old_psls, old_keys, old_values, old_size);
     free(old_hash_keys);
     free(old_psls);
     free(old_keys);
     free(old_values);
+    STATS_resize(ht, start);
     return HT_SUCCESS;    
 }
 
@@ -599,6 +753,136 @@ static inline void clear_entry(
     ht->values[index] = NULL;
 }
 
+/**
+ * @brief Allocates a zeroed, cache line aligned uint32_t array.
+ *
+ * Aligned blocks of SIMD_LANES slots then never straddle a cache line.
+ *
+ * @param size Number of elements.
+ * @return Pointer to the array, or NULL on failure.
+ */
+static uint32_t *alloc_aligned_u32(
+        uint32_t size
+) {
+    void *mem;
+
+    if (posix_memalign(&mem, CACHE_LINE_SIZE, size * sizeof(uint32_t)) != 0) {
+        return NULL;
+    }
+    memset(mem, 0, size * sizeof(uint32_t));
+    return (uint32_t *)mem;
+}
+
+/**
+ * @brief Finds the slot of a key one probe at a time.
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key.
+ * @return Index of the key, or -1 if not found.
+ */
+static int32_t find_index_scalar(
+        const HashTab *ht,
+        uint32_t hash_key,
+        const void *key
+) {
+    uint32_t i, index;
+
+    /* no entry is further than max_psl from its home slot */
+    for (i = 0; i <= ht->max_psl; i++) {
+        /* calculate index to probe */
+        index = probe_func(hash_key, i, ht->size);
+
+        /* empty bucket key not in table */
+        if (ht->keys[index] == NULL) {return -1;}
+        if (
+            ht->hash_keys[index] == hash_key &&
+            ht->cmp_func(ht->keys[index], key) == 0
+        ) {
+            /* key found return */
+            return (int32_t)index;
+        }
+        /* if the current entries psl is less the i(probe length) ,the entry
+         * would have been swapped earlier if if was present */
+        if (ht->psls[index] < i) {return -1;}
+    }
+    return -1;
+}
+
+#ifdef HT_AVX2_KERNEL
+/**
+ * @brief Finds the slot of a key comparing eight slots per step with AVX2.
+ *
+ * Blocks start at multiples of SIMD_LANES, so the first block may begin
+ * before the home slot; those lanes get a negative expected psl and never
+ * match. Lane j of a block is a candidate when its hash matches and its
+ * psl equals the distance from the home slot, the only psl the key could
+ * have there. The first lane with a smaller psl (including empty slots)
+ * ends the search, so only candidates before it are compared with
+ * cmp_func. Tables smaller than a block use the scalar loop.
+ *
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key.
+ * @return Index of the key, or -1 if not found.
+ */
+__attribute__((target("avx2")))
+static int32_t find_index_avx2(
+        const HashTab *ht,
+        uint32_t hash_key,
+        const void *key
+) {
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i needle = _mm256_set1_epi32((int)hash_key);
+    __m256i hashes, psls, expected;
+    uint32_t base, match, stop, current;
+    int32_t dist;
+
+    if (ht->size < SIMD_LANES) {return find_index_scalar(ht, hash_key, key);}
+
+    /* distance of the first lane, <= 0 */
+    dist = -(int32_t)(hash_key & (SIMD_LANES - 1));
+    for (; dist <= (int32_t)ht->max_psl; dist += SIMD_LANES) {
+        base = probe_func(hash_key, (uint32_t)dist, ht->size);
+
+        hashes = _mm256_load_si256((const __m256i *)&ht->hash_keys[base]);
+        psls = _mm256_load_si256((const __m256i *)&ht->psls[base]);
+        expected = _mm256_add_epi32(_mm256_set1_epi32(dist), lanes);
+
+        match = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(
+            _mm256_cmpeq_epi32(hashes, needle),
+            _mm256_cmpeq_epi32(psls, expected)
+        )));
+        stop = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(
+            _mm256_cmpgt_epi32(expected, psls)
+        ));
+        /* keep lanes before the first stop, branch free (all when none) */
+        match &= (stop & (0u - stop)) - 1u;
+
+        for (; match; match &= match - 1) {
+            current = base + (uint32_t)__builtin_ctz(match);
+            if (ht->keys[current] != NULL && ht->cmp_func(ht->keys[current], key) == 0) {
+                return (int32_t)current;
+            }
+        }
+        if (stop) {return -1;}
+    }
+    return -1;
+}
+#endif
+
+/**
+ * @brief Picks the search kernel for the running CPU before main() runs,
+ *        so searches never write the shared kernel pointer.
+ */
+__attribute__((constructor))
+static void init_find_index(
+        void
+) {
+#ifdef HT_AVX2_KERNEL
+    if (ht_cpu_isa() >= HT_ISA_AVX2) {find_index = find_index_avx2;}
+#endif
+}
+
 /**
  * @brief Computes the probe index using linear probing with a power-of-2 table size.
  * @param k Hash key value.
@@ -616,6 +900,24 @@ static inline uint32_t probe_func(
 
 /* --- default functions ---------------------------------------------------- */
 
+/**
+ * @brief Hashes a key with the keyed hash when one is configured.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static inline uint32_t compute_hash(
+    const HashTab *ht,
+    const void *key,
+    size_t len
+) {
+    if (ht->seeded_hash_func) {
+        return ht->seeded_hash_func(key, len, ht->seed);
+    }
+    return ht->hash_func(key, len);
+}
+
 /**
  * @brief Computes a default hash value for a key using the FNV-1a algorithm.
  * @param key Pointer to the key data.
@@ -6,11 +6,15 @@
  * @date    2025-3-31
  */
 
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include "open_table.h"
+#include "ht_hash.h"
 #include "debug_hashtab.h"
+#include "stats_hashtab.h"
 
 #define PRINT_BUFFER_SIZE 1024
 
@@ -60,19 +64,27 @@ struct hashtab {
 
     uint32_t size;       /* Current size (capacity) of the table           */
     uint32_t active;     /* Number of non-empty entries (active)           */
+    uint32_t max_psl;    /* Longest probe sequence length in the table     */
 
     float load_factor;       /* Max load factor before resizing            */
     float min_load_factor;   /* Min load factor to consider downsizing     */
 
     uint32_t (*hash_func)(const void *key, size_t len);
+    uint32_t (*seeded_hash_func)(const void *key, size_t len, uint64_t seed);
+    uint64_t seed;
 	int (*cmp_func)(const void *a, const void *b);
 
     void (*free_key)(void *k);
     void (*free_val)(void *v);
+
+    STATS_fields
 };
 
 /* --- function prototypes -------------------------------------------------- */
 
+static inline uint32_t compute_hash(
+        const HashTab *ht, const void *key, size_t len
+);
 static uint32_t default_hash_func(
         const void *key, size_t len
 );
@@ -90,8 +102,10 @@ static HTResult remove_entry(
         HashTab *ht, uint32_t hash_key, const void *key
 );
 static void shift_entries_backward(
-        HashTab *ht, uint32_t current_index, uint32_t hash_key,
-        uint32_t *probe_count
+        HashTab *ht, uint32_t current_index
+);
+static inline void move_slots_back(
+        HashTab *ht, uint32_t dst, uint32_t count
 );
 static void remove_table_update(
         HashTab *ht
@@ -143,13 +157,21 @@ HashTab *ht_create(
     /* Initialize load tracking variables */
     ht->size = 2;
     ht->active = 0;
+    ht->max_psl = 0;
+    STATS_init(ht);
     
     /* Initialize load factors with defaults if zero */
     ht->load_factor = config->load_factor;
     ht->min_load_factor = config->min_load_factor;
 
     /* Initialize function ptrs withe defaults if NULL */
-    ht->hash_func = config->hash_func ? config->hash_func : default_hash_func;
+    ht->hash_func = config->hash_func ? config->hash_func :
+        ht_hash_for_key_len(config->key_len, default_hash_func);
+    ht->seeded_hash_func = config->seeded_hash_func;
+    ht->seed = config->seed;
+    if (ht->seeded_hash_func && ht->seed == 0) {
+        ht->seed = ht_random_seed(ht);
+    }
     ht->cmp_func = config->cmp_func ? config->cmp_func : default_cmp_func;
     ht->free_key = config->free_key ? config->free_key : NULL;
     ht->free_val = config->free_val ? config->free_val : NULL;
@@ -169,21 +191,45 @@ HashTab *ht_create(
 	return ht;
 }
 
-void *ht_search(
+uint32_t ht_hash(
         const HashTab *ht,
         const void *key,
         size_t key_len
 ) {
-    uint32_t i, hash_key, index;
+    CHECK_NULL(ht, "ht_hash: HashTab NULL", 0);
+    CHECK_NULL(key, "ht_hash: Key NULL", 0);
 
-    DBG_info("ht_search");
+    return compute_hash(ht, key, key_len);
+}
+
+void *ht_search(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
     CHECK_NULL(ht,"ht_search: HashTab NULL", NULL);
     CHECK_NULL(key, "HT_search: Key NULL", NULL);
     CHECK_NONZERO(key_len, "ht_search: Zero key length", NULL);
 
-    hash_key = ht->hash_func(key, key_len);
+    return ht_search_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
 
-    for (i = 0; i < ht->size; i++) {
+void *ht_search_hashed(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    uint32_t i, index;
+
+    DBG_info("ht_search_hashed");
+    CHECK_NULL(ht,"ht_search_hashed: HashTab NULL", NULL);
+    CHECK_NULL(key, "ht_search_hashed: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search_hashed: Zero key length", NULL);
+
+
+    /* no entry is further than max_psl from its home slot */
+    for (i = 0; i <= ht->max_psl; i++) {
         /* calculate index to probe */
         index = probe_func(hash_key, i, ht->size);
 
@@ -202,7 +248,7 @@ void *ht_search(
         if (ht->psls[index] < i) {return NULL;}
     }
 
-    DBG_info("ht_search: Key not found");
+    DBG_info("ht_search_hashed: Key not found");
     return NULL;
     
 }
@@ -213,14 +259,33 @@ HTResult ht_insert(
         size_t key_len,
         void *value
 ) {
-    uint32_t hash_key;
-    HTResult result;
-
     CHECK_NULL(ht, "ht_insert: HashTab NULL", HT_INVALID_ARG);
     CHECK_NULL(key, "ht_insert: Key NULL", HT_INVALID_ARG);
     CHECK_NONZERO(key_len, "ht_insert: Zero key length", HT_INVALID_ARG);
 
-    if (ht_search(ht, key, key_len)) {
+    return ht_insert_hashed(
+        ht,
+        key,
+        key_len,
+        compute_hash(ht, key, key_len),
+        value
+    );
+}
+
+HTResult ht_insert_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key,
+        void *value
+) {
+    HTResult result;
+
+    CHECK_NULL(ht, "ht_insert_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert_hashed: Zero key length", HT_INVALID_ARG);
+
+    if (ht_search_hashed(ht, key, key_len, hash_key)) {
         return HT_KEY_EXISTS;// replace with CHECK_NULL if possible
     }
 
@@ -231,7 +296,6 @@ HTResult ht_insert(
         if (result != HT_SUCCESS) {return result;}
     }
 
-    hash_key = ht->hash_func(key, key_len);
     return insert_entry(
         ht,
         hash_key,
@@ -254,7 +318,19 @@ HTResult ht_remove(HashTab *ht, const void *key, size_t key_len) {
     CHECK_NULL(key, "ht_remove: Key NULL", HT_INVALID_ARG);
     CHECK_NONZERO(key_len, "ht_remove: Zero key length", HT_INVALID_ARG);
 
-    uint32_t hash_key = ht->hash_func(key, key_len);
+    return ht_remove_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+HTResult ht_remove_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    CHECK_NULL(ht, "ht_remove_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove_hashed: Zero key length", HT_INVALID_ARG);
+
     return remove_entry(ht, hash_key, key);
 }
 
@@ -318,6 +394,45 @@ uint32_t ht_capacity(
     return ht->size;
 }
 
+uint32_t ht_max_psl(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_max_psl: HashTab NULL", 0);
+    return ht->max_psl;
+}
+
+HTResult ht_stats(
+        const HashTab *ht,
+        HTStats *out
+) {
+    uint32_t i, psl;
+    uint64_t psl_sum;
+
+    CHECK_NULL(ht, "ht_stats: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(out, "ht_stats: HTStats NULL", HT_INVALID_ARG);
+
+    memset(out, 0, sizeof(*out));
+    out->capacity = ht->size;
+    out->active = ht->active;
+    out->load_factor = (float)ht->active / (float)ht->size;
+
+    psl_sum = 0;
+    for (i = 0; i < ht->size; i++) {
+        if (ht->keys[i] == NULL) {continue;}
+        psl = ht->psls[i];
+        psl_sum += psl;
+        if (psl > out->max_psl) {out->max_psl = psl;}
+        if (psl >= HT_STATS_PSL_BUCKETS) {psl = HT_STATS_PSL_BUCKETS - 1;}
+        out->psl_histogram[psl]++;
+    }
+    out->avg_psl = ht->active ? (double)psl_sum / ht->active : 0.0;
+    out->bytes_allocated = sizeof(HashTab) + (size_t)ht->size *
+        (2 * sizeof(uint32_t) + 2 * sizeof(void *));
+    STATS_export(ht, out);
+
+    return HT_SUCCESS;
+}
+
 /* --- utility functions ---------------------------------------------------- */
 
 /**
@@ -352,10 +467,12 @@ static HTResult insert_entry(
                 value
             );
             ht->active++;
+            if (i > ht->max_psl) {ht->max_psl = i;}
             return HT_SUCCESS;
         }
         /* compare probe length */
         if (i > ht->psls[index]) {
+            if (i > ht->max_psl) {ht->max_psl = i;}
             /* swap "poorer" (further element steals the spot.) */
             temp_hash_key = ht->hash_keys[index];
             temp_psl = ht->psls[index];
@@ -372,8 +489,8 @@ static HTResult insert_entry(
             hash_key = temp_hash_key;
             key = temp_key;
             value = temp_value;
-            //i = temp_psl + 1;
-            //break;
+            /* continue along the displaced entry's own probe sequence */
+            i = temp_psl;
         }
         i++;
     }
@@ -422,7 +539,7 @@ static HTResult remove_entry(
         const void *key
 ) {
     uint32_t probe_count, current_index;
-    for (probe_count = 0; probe_count < ht->size; probe_count++) {
+    for (probe_count = 0; probe_count <= ht->max_psl; probe_count++) {
         current_index = probe_func(hash_key, probe_count, ht->size);
 
         if (ht->keys[current_index] == NULL) {
@@ -434,7 +551,7 @@ static HTResult remove_entry(
             ht->cmp_func(ht->keys[current_index], key) == 0
         ) {
             free_entry(ht, current_index);
-            shift_entries_backward(ht, current_index, hash_key, &probe_count);
+            shift_entries_backward(ht, current_index);
             remove_table_update(ht);
             return HT_SUCCESS;
         }
@@ -448,34 +565,72 @@ static HTResult remove_entry(
 
 /**
  * @brief Shifts subsequent entries backward to fill the gap after removal.
+ *
+ * The run of entries that can move back (occupied with psl > 0) is measured
+ * first and then moved with one memmove per array, split in two pieces when
+ * the run wraps around the end of the table.
+ *
  * @param ht Pointer to the hash table.
- * @param current_index Index of the removed entry.
- * @param hash_key Hash key for probing.
- * @param probe_count Pointer to the current probe iteration (updated in-place).
+ * @param current_index Index of the removed (already cleared) entry.
  */
 static void shift_entries_backward(
         HashTab *ht,
-        uint32_t current_index,
-        uint32_t hash_key,
-        uint32_t *probe_count
+        uint32_t current_index
 ) {
-    uint32_t next_index = probe_func(hash_key, ++(*probe_count), ht->size);
+    uint32_t run, tail, next_index, mask;
 
+    mask = ht->size - 1;
+    run = 0;
+    next_index = (current_index + 1) & mask;
     while (ht->keys[next_index] != NULL && ht->psls[next_index] > 0) {
-        /* Move back and adjust probe sequence length */
+        run++;
+        next_index = (next_index + 1) & mask;
+    }
+    if (run == 0) {return;}
+
+    /* slots between the gap and the end of the arrays */
+    tail = ht->size - 1 - current_index;
+    if (run <= tail) {
+        move_slots_back(ht, current_index, run);
+    } else {
+        move_slots_back(ht, current_index, tail);
+        /* slot 0 wraps around into the last slot */
         set_entry(
             ht,
-            current_index,
-            ht->hash_keys[next_index],
-            ht->psls[next_index] - 1,
-            ht->keys[next_index],
-            ht->values[next_index]
+            ht->size - 1,
+            ht->hash_keys[0],
+            ht->psls[0] - 1,
+            ht->keys[0],
+            ht->values[0]
         );
-        current_index = next_index;
-        next_index = probe_func(hash_key, ++(*probe_count), ht->size);
+        move_slots_back(ht, 0, run - tail - 1);
     }
 
-    clear_entry(ht, current_index);  /* Mark last shifted slot as empty */
+    clear_entry(ht, (current_index + run) & mask);  /* Mark last shifted slot as empty */
+}
+
+/**
+ * @brief Moves count slots starting at dst + 1 back by one slot.
+ * @param ht Pointer to the hash table.
+ * @param dst Index the first moved slot is written to.
+ * @param count Number of slots to move, dst + count must be < ht->size.
+ */
+static inline void move_slots_back(
+        HashTab *ht,
+        uint32_t dst,
+        uint32_t count
+) {
+    uint32_t i;
+
+    if (count == 0) {return;}
+    memmove(&ht->hash_keys[dst], &ht->hash_keys[dst + 1], count * sizeof(uint32_t));
+    memmove(&ht->psls[dst], &ht->psls[dst + 1], count * sizeof(uint32_t));
+    memmove(&ht->keys[dst], &ht->keys[dst + 1], count * sizeof(void *));
+    memmove(&ht->values[dst], &ht->values[dst + 1], count * sizeof(void *));
+    /* contiguous decrement, vectorized by the compiler */
+    for (i = dst; i < dst + count; i++) {
+        ht->psls[i]--;
+    }
 }
 
 /**
@@ -508,6 +663,7 @@ static HTResult resize(
     void **old_values = ht->values;
     uint32_t old_size = ht->size;
     HTResult result;
+    STATS_timer(start);
 
     result = validate_size(ht->size, new_size);
     if (result != HT_SUCCESS) return result;
@@ -530,12 +686,14 @@ static HTResult resize(
 
     ht->size = new_size;
     ht->active = 0;
+    ht->max_psl = 0;
 
     rehash_entries(ht, old_hash_keys, old_psls, old_keys, old_values, old_size);
     free(old_hash_keys);
     free(old_psls);
     free(old_keys);
     free(old_values);
+    STATS_resize(ht, start);
     return HT_SUCCESS;    
 }
 
@@ -611,6 +769,24 @@ static inline uint32_t probe_func(
 
 /* --- default functions ---------------------------------------------------- */
 
+/**
+ * @brief Hashes a key with the keyed hash when one is configured.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static inline uint32_t compute_hash(
+    const HashTab *ht,
+    const void *key,
+    size_t len
+) {
+    if (ht->seeded_hash_func) {
+        return ht->seeded_hash_func(key, len, ht->seed);
+    }
+    return ht->hash_func(key, len);
+}
+
 /**
  * @brief Computes a default hash value for a key using the FNV-1a algorithm.
  * @param key Pointer to the key data.
@@ -0,0 +1,864 @@
+/**
+ * @file    open_table_V1_3.c
+ * @brief   A open addressing hashtable using a SoA layout where the hash code
+ *          and psl of a slot are interleaved in a single metadata array, so a
+ *          probe touches one cache line and keys are only read on a hash match
+ * @author  J.W Moolman
+ * @date    2025-4-14
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "open_table.h"
+#include "ht_hash.h"
+#include "debug_hashtab.h"
+#include "stats_hashtab.h"
+
+#define PRINT_BUFFER_SIZE 1024
+
+#define SAFETY_CHECKS_ENABLED 1
+
+#if SAFETY_CHECKS_ENABLED
+#define LOG_ERROR(fmt, ...) \
+    fprintf(stderr, "%s:%d " fmt "\n", __FILE__, __LINE__, __VA_ARGS__)
+#else
+#define LOG_ERROR(fmt, ...) ((void)0)
+#endif
+
+#define GET_ARG_COUNT(...) GET_ARG_COUNT_HELPER(__VA_ARGS__, 3, 2, 1)
+#define GET_ARG_COUNT_HELPER(_1, _2, _3, count, ...) count
+
+#define CHECK_CONDITION_2(cond, return_val) \
+    do { if (!(cond)) return (return_val); } while (0)
+
+#define CHECK_CONDITION_3(cond, msg, return_val) \
+    do { \
+        if (!(cond)) { \
+            LOG_ERROR("%s", msg); \
+            return (return_val); \
+        } \
+    } while (0)
+
+#define CHECK_CONDITION(...) \
+    _CHECK_CONDITION(GET_ARG_COUNT(__VA_ARGS__), __VA_ARGS__)
+
+#define _CHECK_CONDITION(N, ...) \
+    _CHECK_CONDITION_IMPL(N, __VA_ARGS__)
+
+#define _CHECK_CONDITION_IMPL(N, ...) CHECK_CONDITION_##N(__VA_ARGS__)
+
+#define CHECK_NULL(...) CHECK_CONDITION(__VA_ARGS__)
+#define CHECK_RANGE(val, min, max, ...) \
+    CHECK_CONDITION((val) >= (min) && (val) <= (max), __VA_ARGS__)
+#define CHECK_NONZERO(val, ...) CHECK_CONDITION((val) != 0, __VA_ARGS__)
+
+/* Metadata of a slot, probed without touching the keys array */
+typedef struct {
+    uint32_t hash_key;    /* Cached hash code for quick comparison         */
+    uint32_t psl;         /* Probe sequence length + 1, 0 marks empty slot */
+} HTmeta;
+
+/* a hash table container */
+struct hashtab {
+
+    HTmeta *meta;         /* Array of interleaved hash codes and psls      */
+    void **keys;          /* Array of pointers to key data                 */
+    void **values;        /* Array of pointers to value data               */
+
+    uint32_t size;       /* Current size (capacity) of the table           */
+    uint32_t active;     /* Number of non-empty entries (active)           */
+    uint32_t max_psl;    /* Longest probe sequence length in the table     */
+
+    float load_factor;       /* Max load factor before resizing            */
+    float min_load_factor;   /* Min load factor to consider downsizing     */
+
+    uint32_t (*hash_func)(const void *key, size_t len);
+    uint32_t (*seeded_hash_func)(const void *key, size_t len, uint64_t seed);
+    uint64_t seed;
+	int (*cmp_func)(const void *a, const void *b);
+
+    void (*free_key)(void *k);
+    void (*free_val)(void *v);
+
+    STATS_fields
+};
+
+/* --- function prototypes -------------------------------------------------- */
+
+static inline uint32_t compute_hash(
+        const HashTab *ht, const void *key, size_t len
+);
+static uint32_t default_hash_func(
+        const void *key, size_t len
+);
+static int default_cmp_func(
+        const void *a, const void *b
+);
+static HTResult insert_entry(
+        HashTab *ht, uint32_t hash_key, void *key, void *value
+);
+static void rehash_entries(
+    HashTab *ht, HTmeta *old_meta, void **old_keys, void **old_values,
+    uint32_t old_size
+);
+static HTResult remove_entry(
+        HashTab *ht, uint32_t hash_key, const void *key
+);
+static void shift_entries_backward(
+        HashTab *ht, uint32_t current_index
+);
+static inline void move_slots_back(
+        HashTab *ht, uint32_t dst, uint32_t count
+);
+static void remove_table_update(
+        HashTab *ht
+);
+static HTResult resize(
+        HashTab *ht, uint32_t new_size
+);
+static void free_entry(
+        HashTab *ht, uint32_t index
+);
+static inline void get_entry(
+    const HashTab *ht, uint32_t index, uint32_t *hash_key,
+    uint32_t *psl, void **key, void **value
+);
+static inline void set_entry(
+    HashTab *ht, uint32_t index, uint32_t hash_key,
+    uint32_t psl, void *key, void *value
+);
+static inline void clear_entry(
+    HashTab *ht, uint32_t index
+);
+static inline uint32_t probe_func(
+        uint32_t k, uint32_t i, uint32_t m
+);
+
+static inline HTResult validate_load_factors(
+        float load_factor, float min_load_factor
+);
+static inline HTResult validate_size(
+        uint32_t size, uint32_t new_size
+);
+/* --- hash table interface ------------------------------------------------- */
+
+HashTab *ht_create(
+    const HTConfig *config 
+) {
+    HashTab *ht;
+
+    DBG_start("init_ht_");
+    CHECK_NULL(config, "HTConfig NULL", NULL);
+
+    if (
+        validate_load_factors(config->load_factor, config->min_load_factor) != HT_SUCCESS
+    ) {return NULL;}
+    
+    ht = (HashTab *)malloc(sizeof(HashTab));
+    CHECK_NULL(ht, "Hashtable allocation failed", NULL);
+
+    /* Initialize load tracking variables */
+    ht->size = 2;
+    ht->active = 0;
+    ht->max_psl = 0;
+    STATS_init(ht);
+    
+    /* Initialize load factors with defaults if zero */
+    ht->load_factor = config->load_factor;
+    ht->min_load_factor = config->min_load_factor;
+
+    /* Initialize function ptrs withe defaults if NULL */
+    ht->hash_func = config->hash_func ? config->hash_func :
+        ht_hash_for_key_len(config->key_len, default_hash_func);
+    ht->seeded_hash_func = config->seeded_hash_func;
+    ht->seed = config->seed;
+    if (ht->seeded_hash_func && ht->seed == 0) {
+        ht->seed = ht_random_seed(ht);
+    }
+    ht->cmp_func = config->cmp_func ? config->cmp_func : default_cmp_func;
+    ht->free_key = config->free_key ? config->free_key : NULL;
+    ht->free_val = config->free_val ? config->free_val : NULL;
+
+    /* Initialize structure of arrays for table entries */
+    ht->meta = (HTmeta *)calloc(ht->size, sizeof(HTmeta));
+    ht->keys = (void **)calloc(ht->size, sizeof(void *));
+    ht->values = (void **)calloc(ht->size, sizeof(void *));
+    CHECK_NULL(ht->meta, "Metadata allocation failed", NULL);
+    CHECK_NULL(ht->keys, "Keys allocation failed", NULL);
+    CHECK_NULL(ht->values, "Values allocation failed", NULL);
+
+    DBG_end("_init_ht");
+
+	return ht;
+}
+
+uint32_t ht_hash(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
+    CHECK_NULL(ht, "ht_hash: HashTab NULL", 0);
+    CHECK_NULL(key, "ht_hash: Key NULL", 0);
+
+    return compute_hash(ht, key, key_len);
+}
+
+void *ht_search(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
+    CHECK_NULL(ht,"ht_search: HashTab NULL", NULL);
+    CHECK_NULL(key, "HT_search: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search: Zero key length", NULL);
+
+    return ht_search_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+void *ht_search_hashed(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    uint32_t i, index;
+    const HTmeta *meta;
+
+    DBG_info("ht_search_hashed");
+    CHECK_NULL(ht,"ht_search_hashed: HashTab NULL", NULL);
+    CHECK_NULL(key, "ht_search_hashed: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search_hashed: Zero key length", NULL);
+
+
+    /* no entry is further than max_psl from its home slot */
+    for (i = 0; i <= ht->max_psl; i++) {
+        /* calculate index to probe */
+        index = probe_func(hash_key, i, ht->size);
+        meta = &ht->meta[index];
+
+        /* an empty slot (psl 0) or an entry with a psl less than i (stored
+         * psl <= i) ends the search, the key would have been placed here */
+        if (meta->psl <= i) {return NULL;}
+        if (
+            meta->hash_key == hash_key &&
+            ht->cmp_func(ht->keys[index], key) == 0
+        ) {
+            /* key found return */
+            return ht->values[index];
+        }
+    }
+
+    DBG_info("ht_search_hashed: Key not found");
+    return NULL;
+    
+}
+
+HTResult ht_insert(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        void *value
+) {
+    CHECK_NULL(ht, "ht_insert: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert: Zero key length", HT_INVALID_ARG);
+
+    return ht_insert_hashed(
+        ht,
+        key,
+        key_len,
+        compute_hash(ht, key, key_len),
+        value
+    );
+}
+
+HTResult ht_insert_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key,
+        void *value
+) {
+    HTResult result;
+
+    CHECK_NULL(ht, "ht_insert_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert_hashed: Zero key length", HT_INVALID_ARG);
+
+    if (ht_search_hashed(ht, key, key_len, hash_key)) {
+        return HT_KEY_EXISTS;// replace with CHECK_NULL if possible
+    }
+
+    if (ht->active + 1 > ht->size * ht->load_factor) {
+        result = validate_size(ht->size, ht->size << 1);
+        if (result != HT_SUCCESS) {return result;}
+        result = resize(ht, ht->size << 1);
+        if (result != HT_SUCCESS) {return result;}
+    }
+
+    return insert_entry(
+        ht,
+        hash_key,
+        (void *)key,
+        value
+    );
+}
+
+/**
+ * @brief Removes a key and its associated value from the hash table.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key to remove.
+ * @param key_len Length of the key in bytes.
+ * @return HT_SUCCESS on success,
+ *         HT_INVALID_ARG if inputs are invalid,
+ *         HT_KEY_NOT_FOUND if key isn’t found.
+ */
+HTResult ht_remove(HashTab *ht, const void *key, size_t key_len) {
+    CHECK_NULL(ht, "ht_remove: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove: Zero key length", HT_INVALID_ARG);
+
+    return ht_remove_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+HTResult ht_remove_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    CHECK_NULL(ht, "ht_remove_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove_hashed: Zero key length", HT_INVALID_ARG);
+
+    return remove_entry(ht, hash_key, key);
+}
+
+void ht_destroy(
+		HashTab *ht
+) {
+    uint32_t i;
+
+    if (ht == NULL) {
+        return;
+    }
+
+    for (i = 0; i < ht->size; i++) {
+        if (ht->keys[i] != NULL) {
+            free_entry(ht,i);
+        }
+    }
+
+    free(ht->meta);
+    free(ht->keys);
+    free(ht->values);
+    ht->meta = NULL;
+    ht->keys = NULL;
+    ht->values = NULL;
+    ht->hash_func = NULL;
+    ht->cmp_func = NULL;
+    free(ht);
+}
+
+void ht_print(
+    const HashTab *ht,
+    void (*format_key)(void *key, char *buf, size_t buf_size),
+    void (*format_value)(void *value, char *buf, size_t buf_size)
+) {
+
+    char key_buffer[PRINT_BUFFER_SIZE];
+    char value_buffer[PRINT_BUFFER_SIZE];
+    if (!ht || !format_key || !format_value) return;
+
+    printf("--- HashTab - size[%u] - entries[%u] - loadfct[%.2f] ---\n",
+           ht->size, ht->active, ht->load_factor);
+
+    for (uint32_t i = 0; i < ht->size; i++) {
+        if (ht->keys[i] != NULL) {  // Check if the slot is occupied
+            format_key(ht->keys[i], key_buffer, PRINT_BUFFER_SIZE);
+            format_value(ht->values[i], value_buffer, PRINT_BUFFER_SIZE);
+            printf(
+                    "Index %u: hash=%u, psl=%u, key=%s, value=%s\n", 
+                   i, ht->meta[i].hash_key, ht->meta[i].psl - 1,
+                   key_buffer, value_buffer
+            );
+        }
+    }
+}
+
+uint32_t ht_capacity(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_capacity: HashTab NULL", 0);
+    return ht->size;
+}
+
+uint32_t ht_max_psl(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_max_psl: HashTab NULL", 0);
+    return ht->max_psl;
+}
+
+HTResult ht_stats(
+        const HashTab *ht,
+        HTStats *out
+) {
+    uint32_t i, psl;
+    uint64_t psl_sum;
+
+    CHECK_NULL(ht, "ht_stats: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(out, "ht_stats: HTStats NULL", HT_INVALID_ARG);
+
+    memset(out, 0, sizeof(*out));
+    out->capacity = ht->size;
+    out->active = ht->active;
+    out->load_factor = (float)ht->active / (float)ht->size;
+
+    psl_sum = 0;
+    for (i = 0; i < ht->size; i++) {
+        if (ht->meta[i].psl == 0) {continue;}
+        psl = ht->meta[i].psl - 1;
+        psl_sum += psl;
+        if (psl > out->max_psl) {out->max_psl = psl;}
+        if (psl >= HT_STATS_PSL_BUCKETS) {psl = HT_STATS_PSL_BUCKETS - 1;}
+        out->psl_histogram[psl]++;
+    }
+    out->avg_psl = ht->active ? (double)psl_sum / ht->active : 0.0;
+    out->bytes_allocated = sizeof(HashTab) + (size_t)ht->size *
+        (sizeof(HTmeta) + 2 * sizeof(void *));
+    STATS_export(ht, out);
+
+    return HT_SUCCESS;
+}
+
+/* --- utility functions ---------------------------------------------------- */
+
+/**
+ * @brief Inserts a key-value pair into the hash table using Robin Hood hashing.
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key data.
+ * @param value Pointer to the value data.
+ * @return HT_SUCCESS on success, HT_INVALID_STATE if table is full.
+ */
+static HTResult insert_entry(
+        HashTab *ht,
+        uint32_t hash_key,
+        void *key,
+        void *value
+) {
+    uint32_t i, index, psl, temp_psl, temp_hash_key;
+    void *temp_key, *temp_value;
+
+    i = 0;
+    psl = 0;
+
+    while (i < ht->size) {
+        /* probe relative to the home slot of the entry currently carried */
+        index = probe_func(hash_key, psl, ht->size);
+        /* empty buckect found */
+        if (ht->meta[index].psl == 0) {
+            set_entry(
+                ht,
+                index,
+                hash_key,
+                psl,
+                key,
+                value
+            );
+            ht->active++;
+            if (psl > ht->max_psl) {ht->max_psl = psl;}
+            return HT_SUCCESS;
+        }
+        /* compare probe length (stored psl is offset by one) */
+        if (psl >= ht->meta[index].psl) {
+            if (psl > ht->max_psl) {ht->max_psl = psl;}
+            /* swap "poorer" (further element steals the spot.) */
+            get_entry(
+                ht,
+                index,
+                &temp_hash_key,
+                &temp_psl,
+                &temp_key,
+                &temp_value
+            );
+            set_entry(
+                ht,
+                index,
+                hash_key,
+                psl,
+                key,
+                value
+            );
+            hash_key = temp_hash_key;
+            psl = temp_psl;
+            key = temp_key;
+            value = temp_value;
+        }
+        psl++;
+        i++;
+    }
+
+    /* should never occur */
+    return HT_FAILURE;
+}
+
+/**
+ * @brief Rehashes entries from an old table into a new table during resizing.
+ * @param ht Pointer to the hash table with the new table allocated.
+ * @param old_table Pointer to the old table’s entries.
+ * @param old_size Size of the old table.
+ */
+static void rehash_entries(
+    HashTab *ht,
+    HTmeta *old_meta,
+    void **old_keys,
+    void **old_values,
+    uint32_t old_size
+) {
+    uint32_t i;
+    for (i = 0; i < old_size; i++) {
+        if (old_meta[i].psl != 0) {
+            insert_entry(
+                ht,
+                old_meta[i].hash_key,
+                old_keys[i],
+                old_values[i]
+            );
+        }
+    }
+}
+
+/**
+ * @brief Attempts to find and remove an entry with the given hash key and key.
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key to remove.
+ * @return HT_SUCCESS if removed, HT_KEY_NOT_FOUND if not found.
+ */
+static HTResult remove_entry(
+        HashTab *ht,
+        uint32_t hash_key,
+        const void *key
+) {
+    uint32_t probe_count, current_index;
+    for (probe_count = 0; probe_count <= ht->max_psl; probe_count++) {
+        current_index = probe_func(hash_key, probe_count, ht->size);
+
+        /* empty slot or an entry closer to home than probe_count */
+        if (ht->meta[current_index].psl <= probe_count) {
+            return HT_KEY_NOT_FOUND;
+        }
+
+        if (
+            ht->meta[current_index].hash_key == hash_key &&
+            ht->cmp_func(ht->keys[current_index], key) == 0
+        ) {
+            free_entry(ht, current_index);
+            shift_entries_backward(ht, current_index);
+            remove_table_update(ht);
+            return HT_SUCCESS;
+        }
+    }
+    return HT_KEY_NOT_FOUND;
+}
+
+/**
+ * @brief Shifts subsequent entries backward to fill the gap after removal.
+ *
+ * The run of entries that can move back (occupied with psl > 0) is measured
+ * first and then moved with one memmove per array, split in two pieces when
+ * the run wraps around the end of the table.
+ *
+ * @param ht Pointer to the hash table.
+ * @param current_index Index of the removed (already cleared) entry.
+ */
+static void shift_entries_backward(
+        HashTab *ht,
+        uint32_t current_index
+) {
+    uint32_t run, tail, next_index, mask;
+
+    mask = ht->size - 1;
+    run = 0;
+    next_index = (current_index + 1) & mask;
+    while (ht->meta[next_index].psl > 1) {
+        run++;
+        next_index = (next_index + 1) & mask;
+    }
+    if (run == 0) {return;}
+
+    /* slots between the gap and the end of the arrays */
+    tail = ht->size - 1 - current_index;
+    if (run <= tail) {
+        move_slots_back(ht, current_index, run);
+    } else {
+        move_slots_back(ht, current_index, tail);
+        /* slot 0 wraps around into the last slot */
+        set_entry(
+            ht,
+            ht->size - 1,
+            ht->meta[0].hash_key,
+            ht->meta[0].psl - 2,
+            ht->keys[0],
+            ht->values[0]
+        );
+        move_slots_back(ht, 0, run - tail - 1);
+    }
+
+    clear_entry(ht, (current_index + run) & mask);  /* Mark last shifted slot as empty */
+}
+
+/**
+ * @brief Moves count slots starting at dst + 1 back by one slot.
+ * @param ht Pointer to the hash table.
+ * @param dst Index the first moved slot is written to.
+ * @param count Number of slots to move, dst + count must be < ht->size.
+ */
+static inline void move_slots_back(
+        HashTab *ht,
+        uint32_t dst,
+        uint32_t count
+) {
+    uint32_t i;
+
+    if (count == 0) {return;}
+    memmove(&ht->meta[dst], &ht->meta[dst + 1], count * sizeof(HTmeta));
+    memmove(&ht->keys[dst], &ht->keys[dst + 1], count * sizeof(void *));
+    memmove(&ht->values[dst], &ht->values[dst + 1], count * sizeof(void *));
+    /* contiguous decrement, vectorized by the compiler */
+    for (i = dst; i < dst + count; i++) {
+        ht->meta[i].psl--;
+    }
+}
+
+/**
+ * @brief Updates the table state after removal, including resizing if needed.
+ * @param ht Pointer to the hash table.
+ */
+static void remove_table_update(
+        HashTab *ht
+) {
+    ht->active--;
+    if (ht->active < (float)ht->size * ht->min_load_factor && ht->size > 2) {
+        resize(ht, ht->size / 2);  /* Downsize if below min load factor */
+    }
+}
+
+/**
+ * @brief Resizes the hash table to a new capacity.
+ * @param ht Pointer to the hash table.
+ * @param new_size New capacity of the table.
+ * @return HT_SUCCESS on success, HT_OUT_OF_MEMORY or HT_INVALID_ARG on failure.
+ */
+static HTResult resize(
+        HashTab *ht,
+        uint32_t new_size
+) {
+
+    HTmeta *old_meta = ht->meta;
+    void **old_keys = ht->keys;
+    void **old_values = ht->values;
+    uint32_t old_size = ht->size;
+    HTResult result;
+    STATS_timer(start);
+
+    result = validate_size(ht->size, new_size);
+    if (result != HT_SUCCESS) return result;
+
+    ht->meta = (HTmeta *)calloc(new_size, sizeof(HTmeta));
+    ht->keys = (void **)calloc(new_size, sizeof(void *));
+    ht->values = (void **)calloc(new_size, sizeof(void *));
+    if (!ht->meta || !ht->keys || !ht->values) {
+        free(ht->meta);
+        free(ht->keys);
+        free(ht->values);
+        ht->meta = old_meta;
+        ht->keys = old_keys;
+        ht->values = old_values;
+        return HT_MEM_ERROR;
+    }
+
+    ht->size = new_size;
+    ht->active = 0;
+    ht->max_psl = 0;
+
+    rehash_entries(ht, old_meta, old_keys, old_values, old_size);
+    free(old_meta);
+    free(old_keys);
+    free(old_values);
+    STATS_resize(ht, start);
+    return HT_SUCCESS;    
+}
+
+/**
+ * @brief Frees the memory associated with a hash table entry.
+ * @param ht Pointer to the hash table.
+ * @param entry Pointer to the entry to free.
+ */
+static void free_entry(
+        HashTab *ht,
+        uint32_t index
+) {
+    if (ht->free_key) {ht->free_key(ht->keys[index]);}
+    if (ht->free_val) {ht->free_val(ht->values[index]);}
+    clear_entry(ht, index);
+}
+
+/* Helper function to retrieve all fields of an entry at index */
+static inline void get_entry(
+    const HashTab *ht,
+    uint32_t index, 
+    uint32_t *hash_key,
+    uint32_t *psl, 
+    void **key,
+    void **value
+) {
+    *hash_key = ht->meta[index].hash_key;
+    *psl = ht->meta[index].psl - 1;
+    *key = ht->keys[index];
+    *value = ht->values[index];
+}
+
+/* Helper function to set all fields of an entry at index */
+static inline void set_entry(
+    HashTab *ht,
+    uint32_t index, 
+    uint32_t hash_key,
+    uint32_t psl, 
+    void *key,
+    void *value
+) {
+    ht->meta[index].hash_key = hash_key;
+    ht->meta[index].psl = psl + 1;
+    ht->keys[index] = key;
+    ht->values[index] = value;
+}
+
+/* Helper function to clear an entry */
+static inline void clear_entry(
+    HashTab *ht,
+    uint32_t index
+) {
+    ht->meta[index].hash_key = 0;
+    ht->meta[index].psl = 0;
+    ht->keys[index] = NULL;
+    ht->values[index] = NULL;
+}
+
+/**
+ * @brief Computes the probe index using linear probing with a power-of-2 table size.
+ * @param k Hash key value.
+ * @param i Probe iteration number.
+ * @param m Table size (must be a power of 2).
+ * @return Index into the hash table.
+ */
+static inline uint32_t probe_func(
+    uint32_t k,
+    uint32_t i,
+    uint32_t m
+) {
+    return (k + i) & (m - 1);
+}
+
+/* --- default functions ---------------------------------------------------- */
+
+/**
+ * @brief Hashes a key with the keyed hash when one is configured.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static inline uint32_t compute_hash(
+    const HashTab *ht,
+    const void *key,
+    size_t len
+) {
+    if (ht->seeded_hash_func) {
+        return ht->seeded_hash_func(key, len, ht->seed);
+    }
+    return ht->hash_func(key, len);
+}
+
+/**
+ * @brief Computes a default hash value for a key using the FNV-1a algorithm.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static uint32_t default_hash_func(
+    const void *key,
+    size_t len
+) {
+    const unsigned char *bytes_ptr = (const unsigned char *)key;
+    unsigned int hash = 2166136261u; // FNV offset basis
+    unsigned int fnv_prime = 16777619u; // FNV prime
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes_ptr[i];       // XOR with the byte
+        hash *= fnv_prime;          // Multiply by FNV prime
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Compares two integer keys for equality or ordering.
+ * @param a Pointer to the first key.
+ * @param b Pointer to the second key.
+ * @return Negative if a < b, 0 if a == b, positive if a > b.
+ */
+static int default_cmp_func(
+    const void *a,
+    const void *b
+) {
+    int int_a = *(const int *)a;
+    int int_b = *(const int *)b;
+    return (int_a > int_b) - (int_a < int_b);
+}
+
+/* --- validadation functions ---------------------------------------------- */
+
+/**
+ * @brief Validates load factor values for correctness.
+ * @param load_factor Maximum load factor.
+ * @param min_load_factor Minimum load factor.
+ * @return HT_SUCCESS if valid, HT_INVALID_ARG if invalid.
+ */
+static inline HTResult validate_load_factors(
+    float load_factor,
+    float min_load_factor
+) {
+    if (load_factor <= 0 || load_factor > 1) {
+        LOG_ERROR("Invalid load_factor: %.2f", load_factor);
+        return HT_INVALID_ARG;
+    }
+    if (min_load_factor < 0 || min_load_factor >= load_factor) {
+        LOG_ERROR("Invalid min_load_factor: %.2f", min_load_factor);
+        return HT_INVALID_ARG;
+    }
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Validates a new size against constraints.
+ * @param size Current size of the table.
+ * @param new_size Proposed new size.
+ * @return HT_SUCCESS if valid, HT_INVALID_ARG or HT_OUT_OF_MEMORY if invalid.
+ */
+static inline HTResult validate_size(
+    uint32_t size,
+    uint32_t new_size
+) {
+    (void)size;  /* kept for the shared signature, only the bound matters */
+    if (new_size == 0 || new_size > UINT32_MAX / 2) {
+        LOG_ERROR("Invalid size: %u", new_size);
+        return HT_FAILURE;
+    }
+    return HT_SUCCESS;
+}
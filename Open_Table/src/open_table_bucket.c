@@ -0,0 +1,862 @@
+/**
+ * @file    open_table_bucket.c
+ * @brief   A Robin Hood hashtable using an AoSoA layout: the table is an
+ *          array of 64 byte aligned buckets of eight slots, where the psls
+ *          and hash codes of all eight slots share one cache line and the
+ *          key and value pointers follow in the next lines. Probing and Robin Hood
+ *          ordering work at bucket granularity.
+ * @author  J.W Moolman
+ * @date    2025-4-22
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "open_table.h"
+#include "ht_hash.h"
+#include "debug_hashtab.h"
+#include "stats_hashtab.h"
+
+#define PRINT_BUFFER_SIZE 1024
+
+/** Number of slots in a bucket */
+#define BUCKET_SLOTS 8
+/** Alignment of the bucket array */
+#define CACHE_LINE_SIZE 64
+
+#define SAFETY_CHECKS_ENABLED 1
+
+#if SAFETY_CHECKS_ENABLED
+#define LOG_ERROR(fmt, ...) \
+    fprintf(stderr, "%s:%d " fmt "\n", __FILE__, __LINE__, __VA_ARGS__)
+#else
+#define LOG_ERROR(fmt, ...) ((void)0)
+#endif
+
+#define GET_ARG_COUNT(...) GET_ARG_COUNT_HELPER(__VA_ARGS__, 3, 2, 1)
+#define GET_ARG_COUNT_HELPER(_1, _2, _3, count, ...) count
+
+#define CHECK_CONDITION_2(cond, return_val) \
+    do { if (!(cond)) return (return_val); } while (0)
+
+#define CHECK_CONDITION_3(cond, msg, return_val) \
+    do { \
+        if (!(cond)) { \
+            LOG_ERROR("%s", msg); \
+            return (return_val); \
+        } \
+    } while (0)
+
+#define CHECK_CONDITION(...) \
+    _CHECK_CONDITION(GET_ARG_COUNT(__VA_ARGS__), __VA_ARGS__)
+
+#define _CHECK_CONDITION(N, ...) \
+    _CHECK_CONDITION_IMPL(N, __VA_ARGS__)
+
+#define _CHECK_CONDITION_IMPL(N, ...) CHECK_CONDITION_##N(__VA_ARGS__)
+
+#define CHECK_NULL(...) CHECK_CONDITION(__VA_ARGS__)
+#define CHECK_RANGE(val, min, max, ...) \
+    CHECK_CONDITION((val) >= (min) && (val) <= (max), __VA_ARGS__)
+#define CHECK_NONZERO(val, ...) CHECK_CONDITION((val) != 0, __VA_ARGS__)
+
+/* A bucket of eight slots, the first cache line holds all probe metadata */
+typedef struct {
+    uint16_t psls[BUCKET_SLOTS];      /* Bucket distance + 1, 0 when empty */
+    uint32_t hash_keys[BUCKET_SLOTS]; /* Full hash codes, compared before  *
+                                       * the keys and reused on rehash     */
+    uint8_t reserved[16];             /* Pads the metadata to a full line  */
+    void *keys[BUCKET_SLOTS];         /* Pointers to key data              */
+    void *values[BUCKET_SLOTS];       /* Pointers to value data            */
+} HTbucket;
+
+/* a hash table container */
+struct hashtab {
+    HTbucket *buckets;   /* Cache line aligned array of buckets            */
+    uint32_t num_buckets;/* Number of buckets (power of 2)                 */
+    uint32_t size;       /* Current size (capacity) in slots               */
+    uint32_t active;     /* Number of non-empty entries (active)           */
+    uint32_t max_psl;    /* Longest probe sequence length in buckets       */
+    uint32_t max_slot_psl; /* Longest displacement in slots, see          *
+                            * slot_psl(), reported by ht_max_psl()        */
+
+    float load_factor;       /* Max load factor before resizing            */
+    float min_load_factor;   /* Min load factor to consider downsizing     */
+
+    uint32_t (*hash_func)(const void *key, size_t len);
+    uint32_t (*seeded_hash_func)(const void *key, size_t len, uint64_t seed);
+    uint64_t seed;
+	int (*cmp_func)(const void *a, const void *b);
+
+    void (*free_key)(void *k);
+    void (*free_val)(void *v);
+
+    STATS_fields
+};
+
+/* --- function prototypes -------------------------------------------------- */
+
+static inline uint32_t compute_hash(
+        const HashTab *ht, const void *key, size_t len
+);
+static uint32_t default_hash_func(
+        const void *key, size_t len
+);
+static int default_cmp_func(
+        const void *a, const void *b
+);
+static HTResult insert_entry(
+        HashTab *ht, uint32_t hash_key, void *key, void *value
+);
+static void rehash_entries(
+        HashTab *ht, HTbucket *old_buckets, uint32_t old_num_buckets
+);
+static HTResult remove_entry(
+        HashTab *ht, uint32_t hash_key, const void *key
+);
+static void shift_entries_backward(
+        HashTab *ht, uint32_t bucket_index, uint32_t slot
+);
+static void remove_table_update(
+        HashTab *ht
+);
+static HTResult resize(
+        HashTab *ht, uint32_t new_num_buckets
+);
+static HTbucket *alloc_buckets(
+        uint32_t num_buckets
+);
+static void free_entry(
+        HashTab *ht, HTbucket *bucket, uint32_t slot
+);
+static inline void move_slot(
+        HTbucket *dst, uint32_t dst_slot, HTbucket *src, uint32_t src_slot
+);
+static inline uint32_t probe_func(
+        uint32_t k, uint32_t i, uint32_t m
+);
+static inline uint32_t slot_psl(
+        uint16_t psl, uint32_t slot
+);
+
+static inline HTResult validate_load_factors(
+        float load_factor, float min_load_factor
+);
+static inline HTResult validate_size(
+        uint32_t size, uint32_t new_size
+);
+/* --- hash table interface ------------------------------------------------- */
+
+HashTab *ht_create(
+    const HTConfig *config
+) {
+    HashTab *ht;
+
+    DBG_start("init_ht_");
+    CHECK_NULL(config, "HTConfig NULL", NULL);
+
+    if (
+        validate_load_factors(config->load_factor, config->min_load_factor) != HT_SUCCESS
+    ) {return NULL;}
+
+    ht = (HashTab *)malloc(sizeof(HashTab));
+    CHECK_NULL(ht, "Hashtable allocation failed", NULL);
+
+    /* Initialize load tracking variables, starting with a single bucket */
+    ht->num_buckets = 1;
+    ht->size = BUCKET_SLOTS;
+    ht->active = 0;
+    ht->max_psl = 0;
+    ht->max_slot_psl = 0;
+    STATS_init(ht);
+
+    /* Initialize load factors with defaults if zero */
+    ht->load_factor = config->load_factor;
+    ht->min_load_factor = config->min_load_factor;
+
+    /* Initialize function ptrs withe defaults if NULL */
+    ht->hash_func = config->hash_func ? config->hash_func :
+        ht_hash_for_key_len(config->key_len, default_hash_func);
+    ht->seeded_hash_func = config->seeded_hash_func;
+    ht->seed = config->seed;
+    if (ht->seeded_hash_func && ht->seed == 0) {
+        ht->seed = ht_random_seed(ht);
+    }
+    ht->cmp_func = config->cmp_func ? config->cmp_func : default_cmp_func;
+    ht->free_key = config->free_key ? config->free_key : NULL;
+    ht->free_val = config->free_val ? config->free_val : NULL;
+
+    ht->buckets = alloc_buckets(ht->num_buckets);
+    if (ht->buckets == NULL) {
+        LOG_ERROR("%s", "Bucket allocation failed");
+        free(ht);
+        return NULL;
+    }
+
+    DBG_end("_init_ht");
+
+	return ht;
+}
+
+uint32_t ht_hash(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
+    CHECK_NULL(ht, "ht_hash: HashTab NULL", 0);
+    CHECK_NULL(key, "ht_hash: Key NULL", 0);
+
+    return compute_hash(ht, key, key_len);
+}
+
+void *ht_search(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
+    CHECK_NULL(ht,"ht_search: HashTab NULL", NULL);
+    CHECK_NULL(key, "HT_search: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search: Zero key length", NULL);
+
+    return ht_search_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+void *ht_search_hashed(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    uint32_t i, s;
+    uint16_t want, min_psl;
+    const HTbucket *bucket;
+
+    DBG_info("ht_search_hashed");
+    CHECK_NULL(ht,"ht_search_hashed: HashTab NULL", NULL);
+    CHECK_NULL(key, "ht_search_hashed: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search_hashed: Zero key length", NULL);
+
+    /* no entry is further than max_psl buckets from its home bucket */
+    for (i = 0; i <= ht->max_psl; i++) {
+        bucket = &ht->buckets[probe_func(hash_key, i, ht->num_buckets)];
+        want = (uint16_t)(i + 1);
+        min_psl = UINT16_MAX;
+
+        for (s = 0; s < BUCKET_SLOTS; s++) {
+            if (
+                bucket->psls[s] == want &&
+                bucket->hash_keys[s] == hash_key &&
+                ht->cmp_func(bucket->keys[s], key) == 0
+            ) {
+                /* key found return */
+                return bucket->values[s];
+            }
+            if (bucket->psls[s] < min_psl) {min_psl = bucket->psls[s];}
+        }
+        /* a key passing this bucket would have displaced any entry (or
+         * empty slot) closer to its home than itself */
+        if (min_psl < want) {return NULL;}
+    }
+
+    DBG_info("ht_search_hashed: Key not found");
+    return NULL;
+}
+
+HTResult ht_insert(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        void *value
+) {
+    CHECK_NULL(ht, "ht_insert: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert: Zero key length", HT_INVALID_ARG);
+
+    return ht_insert_hashed(
+        ht,
+        key,
+        key_len,
+        compute_hash(ht, key, key_len),
+        value
+    );
+}
+
+HTResult ht_insert_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key,
+        void *value
+) {
+    HTResult result;
+
+    CHECK_NULL(ht, "ht_insert_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert_hashed: Zero key length", HT_INVALID_ARG);
+
+    if (ht_search_hashed(ht, key, key_len, hash_key)) {
+        return HT_KEY_EXISTS;
+    }
+
+    if (ht->active + 1 > ht->size * ht->load_factor) {
+        result = validate_size(ht->size, ht->size << 1);
+        if (result != HT_SUCCESS) {return result;}
+        result = resize(ht, ht->num_buckets << 1);
+        if (result != HT_SUCCESS) {return result;}
+    }
+
+    return insert_entry(
+        ht,
+        hash_key,
+        (void *)key,
+        value
+    );
+}
+
+/**
+ * @brief Removes a key and its associated value from the hash table.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key to remove.
+ * @param key_len Length of the key in bytes.
+ * @return HT_SUCCESS on success,
+ *         HT_INVALID_ARG if inputs are invalid,
+ *         HT_KEY_NOT_FOUND if key isn’t found.
+ */
+HTResult ht_remove(HashTab *ht, const void *key, size_t key_len) {
+    CHECK_NULL(ht, "ht_remove: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove: Zero key length", HT_INVALID_ARG);
+
+    return ht_remove_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+HTResult ht_remove_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    CHECK_NULL(ht, "ht_remove_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove_hashed: Zero key length", HT_INVALID_ARG);
+
+    return remove_entry(ht, hash_key, key);
+}
+
+void ht_destroy(
+		HashTab *ht
+) {
+    uint32_t b, s;
+
+    if (ht == NULL) {
+        return;
+    }
+
+    for (b = 0; b < ht->num_buckets; b++) {
+        for (s = 0; s < BUCKET_SLOTS; s++) {
+            if (ht->buckets[b].psls[s] != 0) {
+                free_entry(ht, &ht->buckets[b], s);
+            }
+        }
+    }
+
+    free(ht->buckets);
+    ht->buckets = NULL;
+    ht->hash_func = NULL;
+    ht->cmp_func = NULL;
+    free(ht);
+}
+
+void ht_print(
+    const HashTab *ht,
+    void (*format_key)(void *key, char *buf, size_t buf_size),
+    void (*format_value)(void *value, char *buf, size_t buf_size)
+) {
+    char key_buffer[PRINT_BUFFER_SIZE];
+    char value_buffer[PRINT_BUFFER_SIZE];
+    const HTbucket *bucket;
+    if (!ht || !format_key || !format_value) return;
+
+    printf("--- HashTab - size[%u] - entries[%u] - loadfct[%.2f] ---\n",
+           ht->size, ht->active, ht->load_factor);
+
+    for (uint32_t b = 0; b < ht->num_buckets; b++) {
+        bucket = &ht->buckets[b];
+        for (uint32_t s = 0; s < BUCKET_SLOTS; s++) {
+            if (bucket->psls[s] == 0) {continue;}
+            format_key(bucket->keys[s], key_buffer, PRINT_BUFFER_SIZE);
+            format_value(bucket->values[s], value_buffer, PRINT_BUFFER_SIZE);
+            printf(
+                "Bucket %u slot %u: hash=%u, psl=%u, key=%s, value=%s\n",
+                b, s, bucket->hash_keys[s], bucket->psls[s] - 1u,
+                key_buffer, value_buffer
+            );
+        }
+    }
+}
+
+uint32_t ht_capacity(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_capacity: HashTab NULL", 0);
+    return ht->size;
+}
+
+uint32_t ht_max_psl(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_max_psl: HashTab NULL", 0);
+    return ht->max_slot_psl;
+}
+
+HTResult ht_stats(
+        const HashTab *ht,
+        HTStats *out
+) {
+    uint32_t b, s, psl;
+    uint64_t psl_sum;
+
+    CHECK_NULL(ht, "ht_stats: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(out, "ht_stats: HTStats NULL", HT_INVALID_ARG);
+
+    memset(out, 0, sizeof(*out));
+    out->capacity = ht->size;
+    out->active = ht->active;
+    out->load_factor = (float)ht->active / (float)ht->size;
+
+    /* psls are reported in slots, like the single slot variants */
+    psl_sum = 0;
+    for (b = 0; b < ht->num_buckets; b++) {
+        for (s = 0; s < BUCKET_SLOTS; s++) {
+            if (ht->buckets[b].psls[s] == 0) {continue;}
+            psl = slot_psl(ht->buckets[b].psls[s], s);
+            psl_sum += psl;
+            if (psl > out->max_psl) {out->max_psl = psl;}
+            if (psl >= HT_STATS_PSL_BUCKETS) {psl = HT_STATS_PSL_BUCKETS - 1;}
+            out->psl_histogram[psl]++;
+        }
+    }
+    out->avg_psl = ht->active ? (double)psl_sum / ht->active : 0.0;
+    out->bytes_allocated = sizeof(HashTab) +
+        (size_t)ht->num_buckets * sizeof(HTbucket);
+    STATS_export(ht, out);
+
+    return HT_SUCCESS;
+}
+
+/* --- utility functions ---------------------------------------------------- */
+
+/**
+ * @brief Inserts a key-value pair using Robin Hood hashing over buckets.
+ *
+ * An entry goes into the first free slot of its probe sequence. When the
+ * bucket is full, the carried entry swaps with the resident closest to its
+ * home bucket if the carried entry is further from its own.
+ *
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key data.
+ * @param value Pointer to the value data.
+ * @return HT_SUCCESS on success, HT_FAILURE if table is full.
+ */
+static HTResult insert_entry(
+        HashTab *ht,
+        uint32_t hash_key,
+        void *key,
+        void *value
+) {
+    uint32_t i, s, min_slot, temp_hash_key;
+    uint16_t psl, min_psl, temp_psl;
+    void *temp_key, *temp_value;
+    HTbucket *bucket;
+
+    psl = 1;
+    for (i = 0; i < ht->num_buckets; i++) {
+        /* probe relative to the home bucket of the entry currently carried */
+        bucket = &ht->buckets[probe_func(hash_key, psl - 1u, ht->num_buckets)];
+        min_slot = 0;
+        min_psl = UINT16_MAX;
+        for (s = 0; s < BUCKET_SLOTS; s++) {
+            if (bucket->psls[s] < min_psl) {
+                min_psl = bucket->psls[s];
+                min_slot = s;
+            }
+        }
+
+        if (psl > min_psl) {
+            if (psl - 1u > ht->max_psl) {ht->max_psl = psl - 1u;}
+            if (slot_psl(psl, min_slot) > ht->max_slot_psl) {
+                ht->max_slot_psl = slot_psl(psl, min_slot);
+            }
+            /* empty slot found */
+            if (min_psl == 0) {
+                bucket->psls[min_slot] = psl;
+                bucket->hash_keys[min_slot] = hash_key;
+                bucket->keys[min_slot] = key;
+                bucket->values[min_slot] = value;
+                ht->active++;
+                return HT_SUCCESS;
+            }
+            /* swap "poorer" (further element steals the spot.) */
+            temp_hash_key = bucket->hash_keys[min_slot];
+            temp_psl = bucket->psls[min_slot];
+            temp_key = bucket->keys[min_slot];
+            temp_value = bucket->values[min_slot];
+            bucket->psls[min_slot] = psl;
+            bucket->hash_keys[min_slot] = hash_key;
+            bucket->keys[min_slot] = key;
+            bucket->values[min_slot] = value;
+            hash_key = temp_hash_key;
+            psl = temp_psl;
+            key = temp_key;
+            value = temp_value;
+        }
+        psl++;
+    }
+
+    /* should never occur */
+    return HT_FAILURE;
+}
+
+/**
+ * @brief Rehashes entries from old buckets into the table during resizing.
+ * @param ht Pointer to the hash table with the new buckets allocated.
+ * @param old_buckets Pointer to the old bucket array.
+ * @param old_num_buckets Number of buckets in the old array.
+ */
+static void rehash_entries(
+        HashTab *ht,
+        HTbucket *old_buckets,
+        uint32_t old_num_buckets
+) {
+    uint32_t b, s;
+    for (b = 0; b < old_num_buckets; b++) {
+        for (s = 0; s < BUCKET_SLOTS; s++) {
+            if (old_buckets[b].psls[s] != 0) {
+                insert_entry(
+                    ht,
+                    old_buckets[b].hash_keys[s],
+                    old_buckets[b].keys[s],
+                    old_buckets[b].values[s]
+                );
+            }
+        }
+    }
+}
+
+/**
+ * @brief Attempts to find and remove an entry with the given hash key and key.
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key to remove.
+ * @return HT_SUCCESS if removed, HT_KEY_NOT_FOUND if not found.
+ */
+static HTResult remove_entry(
+        HashTab *ht,
+        uint32_t hash_key,
+        const void *key
+) {
+    uint32_t i, s, bucket_index;
+    uint16_t want, min_psl;
+    HTbucket *bucket;
+
+    for (i = 0; i <= ht->max_psl; i++) {
+        bucket_index = probe_func(hash_key, i, ht->num_buckets);
+        bucket = &ht->buckets[bucket_index];
+        want = (uint16_t)(i + 1);
+        min_psl = UINT16_MAX;
+
+        for (s = 0; s < BUCKET_SLOTS; s++) {
+            if (
+                bucket->psls[s] == want &&
+                bucket->hash_keys[s] == hash_key &&
+                ht->cmp_func(bucket->keys[s], key) == 0
+            ) {
+                free_entry(ht, bucket, s);
+                shift_entries_backward(ht, bucket_index, s);
+                remove_table_update(ht);
+                return HT_SUCCESS;
+            }
+            if (bucket->psls[s] < min_psl) {min_psl = bucket->psls[s];}
+        }
+        if (min_psl < want) {return HT_KEY_NOT_FOUND;}
+    }
+    return HT_KEY_NOT_FOUND;
+}
+
+/**
+ * @brief Pulls entries back one bucket to fill the gap after removal.
+ *
+ * The entry furthest from home in the next bucket moves into the gap, which
+ * keeps every bucket on a probe path full of entries at least as far from
+ * home as the keys passing it. This repeats until the next bucket has no
+ * entry away from its home bucket.
+ *
+ * @param ht Pointer to the hash table.
+ * @param bucket_index Index of the bucket holding the gap.
+ * @param slot Slot of the removed (already cleared) entry.
+ */
+static void shift_entries_backward(
+        HashTab *ht,
+        uint32_t bucket_index,
+        uint32_t slot
+) {
+    uint32_t s, next_index, max_slot;
+    uint16_t max_psl;
+    HTbucket *next;
+
+    for (;;) {
+        next_index = probe_func(bucket_index, 1, ht->num_buckets);
+        next = &ht->buckets[next_index];
+        max_slot = 0;
+        max_psl = 0;
+        for (s = 0; s < BUCKET_SLOTS; s++) {
+            if (next->psls[s] > max_psl) {
+                max_psl = next->psls[s];
+                max_slot = s;
+            }
+        }
+        /* only entries away from their home bucket can move back */
+        if (max_psl < 2) {return;}
+
+        move_slot(&ht->buckets[bucket_index], slot, next, max_slot);
+        ht->buckets[bucket_index].psls[slot]--;
+        bucket_index = next_index;
+        slot = max_slot;
+    }
+}
+
+/**
+ * @brief Updates the table state after removal, including resizing if needed.
+ * @param ht Pointer to the hash table.
+ */
+static void remove_table_update(
+        HashTab *ht
+) {
+    ht->active--;
+    if (
+        ht->active < (float)ht->size * ht->min_load_factor &&
+        ht->num_buckets > 1
+    ) {
+        resize(ht, ht->num_buckets / 2);  /* Downsize if below min load factor */
+    }
+}
+
+/**
+ * @brief Resizes the hash table to a new number of buckets.
+ * @param ht Pointer to the hash table.
+ * @param new_num_buckets New number of buckets (power of 2).
+ * @return HT_SUCCESS on success, HT_MEM_ERROR or HT_FAILURE on failure.
+ */
+static HTResult resize(
+        HashTab *ht,
+        uint32_t new_num_buckets
+) {
+    HTbucket *old_buckets, *new_buckets;
+    uint32_t old_num_buckets;
+    HTResult result;
+    STATS_timer(start);
+
+    result = validate_size(ht->size, new_num_buckets * BUCKET_SLOTS);
+    if (result != HT_SUCCESS) {return result;}
+
+    new_buckets = alloc_buckets(new_num_buckets);
+    CHECK_NULL(new_buckets, "Resize allocation failed", HT_MEM_ERROR);
+
+    old_buckets = ht->buckets;
+    old_num_buckets = ht->num_buckets;
+
+    ht->buckets = new_buckets;
+    ht->num_buckets = new_num_buckets;
+    ht->size = new_num_buckets * BUCKET_SLOTS;
+    ht->active = 0;
+    ht->max_psl = 0;
+    ht->max_slot_psl = 0;
+
+    rehash_entries(ht, old_buckets, old_num_buckets);
+    free(old_buckets);
+    STATS_resize(ht, start);
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Allocates a zeroed, cache line aligned array of buckets.
+ * @param num_buckets Number of buckets to allocate.
+ * @return Pointer to the bucket array, or NULL on failure.
+ */
+static HTbucket *alloc_buckets(
+        uint32_t num_buckets
+) {
+    void *mem;
+
+    if (posix_memalign(&mem, CACHE_LINE_SIZE, num_buckets * sizeof(HTbucket)) != 0) {
+        return NULL;
+    }
+    memset(mem, 0, num_buckets * sizeof(HTbucket));
+    return (HTbucket *)mem;
+}
+
+/**
+ * @brief Frees the memory associated with a slot and marks it empty.
+ * @param ht Pointer to the hash table.
+ * @param bucket Pointer to the bucket holding the slot.
+ * @param slot Index of the slot within the bucket.
+ */
+static void free_entry(
+        HashTab *ht,
+        HTbucket *bucket,
+        uint32_t slot
+) {
+    if (ht->free_key) {ht->free_key(bucket->keys[slot]);}
+    if (ht->free_val) {ht->free_val(bucket->values[slot]);}
+    bucket->psls[slot] = 0;
+    bucket->hash_keys[slot] = 0;
+    bucket->keys[slot] = NULL;
+    bucket->values[slot] = NULL;
+}
+
+/* Helper function to move a slot between buckets, leaving the source empty */
+static inline void move_slot(
+        HTbucket *dst,
+        uint32_t dst_slot,
+        HTbucket *src,
+        uint32_t src_slot
+) {
+    dst->psls[dst_slot] = src->psls[src_slot];
+    dst->hash_keys[dst_slot] = src->hash_keys[src_slot];
+    dst->keys[dst_slot] = src->keys[src_slot];
+    dst->values[dst_slot] = src->values[src_slot];
+    src->psls[src_slot] = 0;
+    src->hash_keys[src_slot] = 0;
+    src->keys[src_slot] = NULL;
+    src->values[src_slot] = NULL;
+}
+
+/**
+ * @brief Computes the bucket index using linear probing over buckets.
+ * @param k Hash key value.
+ * @param i Probe iteration number.
+ * @param m Number of buckets (must be a power of 2).
+ * @return Index into the bucket array.
+ */
+static inline uint32_t probe_func(
+    uint32_t k,
+    uint32_t i,
+    uint32_t m
+) {
+    return (k + i) & (m - 1);
+}
+
+/**
+ * @brief Slot displacement of an entry: its distance from the first slot of
+ *        its home bucket, counting BUCKET_SLOTS per bucket passed.
+ * @param psl Stored bucket distance + 1.
+ * @param slot Index of the entry's slot within its bucket.
+ * @return Displacement in slots.
+ */
+static inline uint32_t slot_psl(
+    uint16_t psl,
+    uint32_t slot
+) {
+    return (psl - 1u) * BUCKET_SLOTS + slot;
+}
+
+/* --- default functions ---------------------------------------------------- */
+
+/**
+ * @brief Hashes a key with the keyed hash when one is configured.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static inline uint32_t compute_hash(
+    const HashTab *ht,
+    const void *key,
+    size_t len
+) {
+    if (ht->seeded_hash_func) {
+        return ht->seeded_hash_func(key, len, ht->seed);
+    }
+    return ht->hash_func(key, len);
+}
+
+/**
+ * @brief Computes a default hash value for a key using the FNV-1a algorithm.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static uint32_t default_hash_func(
+    const void *key,
+    size_t len
+) {
+    const unsigned char *bytes_ptr = (const unsigned char *)key;
+    unsigned int hash = 2166136261u; // FNV offset basis
+    unsigned int fnv_prime = 16777619u; // FNV prime
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes_ptr[i];       // XOR with the byte
+        hash *= fnv_prime;          // Multiply by FNV prime
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Compares two integer keys for equality or ordering.
+ * @param a Pointer to the first key.
+ * @param b Pointer to the second key.
+ * @return Negative if a < b, 0 if a == b, positive if a > b.
+ */
+static int default_cmp_func(
+    const void *a,
+    const void *b
+) {
+    int int_a = *(const int *)a;
+    int int_b = *(const int *)b;
+    return (int_a > int_b) - (int_a < int_b);
+}
+
+/* --- validadation functions ---------------------------------------------- */
+
+/**
+ * @brief Validates load factor values for correctness.
+ * @param load_factor Maximum load factor.
+ * @param min_load_factor Minimum load factor.
+ * @return HT_SUCCESS if valid, HT_INVALID_ARG if invalid.
+ */
+static inline HTResult validate_load_factors(
+    float load_factor,
+    float min_load_factor
+) {
+    if (load_factor <= 0 || load_factor > 1) {
+        LOG_ERROR("Invalid load_factor: %.2f", load_factor);
+        return HT_INVALID_ARG;
+    }
+    if (min_load_factor < 0 || min_load_factor >= load_factor) {
+        LOG_ERROR("Invalid min_load_factor: %.2f", min_load_factor);
+        return HT_INVALID_ARG;
+    }
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Validates a new size against constraints.
+ * @param size Current size of the table.
+ * @param new_size Proposed new size in slots.
+ * @return HT_SUCCESS if valid, HT_FAILURE if invalid.
+ */
+static inline HTResult validate_size(
+    uint32_t size,
+    uint32_t new_size
+) {
+    (void)size;
+    if (new_size == 0 || new_size > UINT32_MAX / 2) {
+        LOG_ERROR("Invalid size: %u", new_size);
+        return HT_FAILURE;
+    }
+    return HT_SUCCESS;
+}
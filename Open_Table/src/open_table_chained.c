@@ -0,0 +1,825 @@
+/**
+ * @file    open_table_chained.c
+ * @brief   A separate chaining hashtable for load factors above 1. Each
+ *          bucket head fills one cache line with the tags and pointers of
+ *          its first HEAD_SLOTS nodes, further nodes hang off an overflow
+ *          chain. Nodes come from a slab pool with a free list instead of
+ *          one malloc per entry, and survive resizes untouched.
+ * @author  J.W Moolman
+ * @date    2025-4-22
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "open_table.h"
+#include "ht_hash.h"
+#include "debug_hashtab.h"
+#include "stats_hashtab.h"
+
+#define PRINT_BUFFER_SIZE 1024
+
+/** Number of nodes referenced from the bucket head */
+#define HEAD_SLOTS 4
+/** Number of nodes carved from one slab */
+#define SLAB_NODES 256
+/** Largest accepted load factor (entries per bucket) */
+#define MAX_LOAD_FACTOR 4.0f
+/** Alignment of the bucket array */
+#define CACHE_LINE_SIZE 64
+
+#define SAFETY_CHECKS_ENABLED 1
+
+#if SAFETY_CHECKS_ENABLED
+#define LOG_ERROR(fmt, ...) \
+    fprintf(stderr, "%s:%d " fmt "\n", __FILE__, __LINE__, __VA_ARGS__)
+#else
+#define LOG_ERROR(fmt, ...) ((void)0)
+#endif
+
+#define GET_ARG_COUNT(...) GET_ARG_COUNT_HELPER(__VA_ARGS__, 3, 2, 1)
+#define GET_ARG_COUNT_HELPER(_1, _2, _3, count, ...) count
+
+#define CHECK_CONDITION_2(cond, return_val) \
+    do { if (!(cond)) return (return_val); } while (0)
+
+#define CHECK_CONDITION_3(cond, msg, return_val) \
+    do { \
+        if (!(cond)) { \
+            LOG_ERROR("%s", msg); \
+            return (return_val); \
+        } \
+    } while (0)
+
+#define CHECK_CONDITION(...) \
+    _CHECK_CONDITION(GET_ARG_COUNT(__VA_ARGS__), __VA_ARGS__)
+
+#define _CHECK_CONDITION(N, ...) \
+    _CHECK_CONDITION_IMPL(N, __VA_ARGS__)
+
+#define _CHECK_CONDITION_IMPL(N, ...) CHECK_CONDITION_##N(__VA_ARGS__)
+
+#define CHECK_NULL(...) CHECK_CONDITION(__VA_ARGS__)
+#define CHECK_RANGE(val, min, max, ...) \
+    CHECK_CONDITION((val) >= (min) && (val) <= (max), __VA_ARGS__)
+#define CHECK_NONZERO(val, ...) CHECK_CONDITION((val) != 0, __VA_ARGS__)
+
+/* Tag stored in the bucket head, the bucket is taken from the low hash bits */
+#define HASH_TAG(hash_key) ((uint16_t)((hash_key) >> 16))
+
+typedef struct htnode HTnode;
+
+/* a chained entry */
+struct htnode {
+    uint32_t hash_key;   /* Cached hash code for quicker comparison      */
+    void *key;           /* Pointer to key data                          */
+    void *value;         /* Pointer to value data                        */
+    HTnode *next;        /* Next overflow node, or next free node        */
+};
+
+/* A bucket head of one cache line, head slot s is empty when nodes[s] is NULL.
+ * Pointers come first so the padding is the only slack in the line. */
+typedef struct {
+    HTnode *nodes[HEAD_SLOTS];   /* First nodes of the bucket             */
+    HTnode *overflow;            /* Chain of the remaining nodes          */
+    uint16_t tags[HEAD_SLOTS];   /* Upper 16 bits of the head node hashes */
+    uint32_t count;              /* Number of entries in the bucket       */
+    uint8_t reserved[CACHE_LINE_SIZE - (HEAD_SLOTS + 1) * sizeof(HTnode *) -
+                     HEAD_SLOTS * sizeof(uint16_t) - sizeof(uint32_t)];
+} HTbucket;
+
+/* Aligned buckets must not straddle cache lines */
+typedef char htbucket_fills_line[sizeof(HTbucket) == CACHE_LINE_SIZE ? 1 : -1];
+
+/* a block of nodes, slabs are only released when the table is destroyed */
+typedef struct htslab {
+    struct htslab *next;
+    HTnode nodes[SLAB_NODES];
+} HTslab;
+
+/* a hash table container */
+struct hashtab {
+    HTbucket *buckets;   /* Cache line aligned array of bucket heads     */
+    uint32_t size;       /* Current number of buckets (power of 2)       */
+    uint32_t active;     /* Number of entries                            */
+    uint32_t max_psl;    /* Longest bucket length minus one              */
+
+    HTslab *slabs;       /* All node slabs                               */
+    HTnode *free_nodes;  /* Free list threaded through HTnode.next       */
+
+    float load_factor;       /* Max load factor before resizing          */
+    float min_load_factor;   /* Min load factor to consider downsizing   */
+
+    uint32_t (*hash_func)(const void *key, size_t len);
+    uint32_t (*seeded_hash_func)(const void *key, size_t len, uint64_t seed);
+    uint64_t seed;
+	int (*cmp_func)(const void *a, const void *b);
+
+    void (*free_key)(void *k);
+    void (*free_val)(void *v);
+
+    STATS_fields
+};
+
+/* --- function prototypes -------------------------------------------------- */
+
+static inline uint32_t compute_hash(
+        const HashTab *ht, const void *key, size_t len
+);
+static uint32_t default_hash_func(
+        const void *key, size_t len
+);
+static int default_cmp_func(
+        const void *a, const void *b
+);
+static void link_node(
+        HashTab *ht, HTbucket *bucket, HTnode *node
+);
+static HTnode *find_node(
+        const HashTab *ht, const HTbucket *bucket,
+        uint32_t hash_key, const void *key
+);
+static HTResult remove_entry(
+        HashTab *ht, uint32_t hash_key, const void *key
+);
+static void remove_table_update(
+        HashTab *ht
+);
+static HTResult resize(
+        HashTab *ht, uint32_t new_size
+);
+static HTbucket *alloc_buckets(
+        uint32_t size
+);
+static HTnode *node_alloc(
+        HashTab *ht
+);
+static void node_free(
+        HashTab *ht, HTnode *node
+);
+static inline uint32_t bucket_index(
+        uint32_t hash_key, uint32_t m
+);
+
+static inline HTResult validate_load_factors(
+        float load_factor, float min_load_factor
+);
+static inline HTResult validate_size(
+        uint32_t size, uint32_t new_size
+);
+/* --- hash table interface ------------------------------------------------- */
+
+HashTab *ht_create(
+    const HTConfig *config
+) {
+    HashTab *ht;
+
+    DBG_start("init_ht_");
+    CHECK_NULL(config, "HTConfig NULL", NULL);
+
+    if (
+        validate_load_factors(config->load_factor, config->min_load_factor) != HT_SUCCESS
+    ) {return NULL;}
+
+    ht = (HashTab *)malloc(sizeof(HashTab));
+    CHECK_NULL(ht, "Hashtable allocation failed", NULL);
+
+    /* Initialize load tracking variables */
+    ht->size = 2;
+    ht->active = 0;
+    ht->max_psl = 0;
+    ht->slabs = NULL;
+    ht->free_nodes = NULL;
+    STATS_init(ht);
+
+    /* Initialize load factors with defaults if zero */
+    ht->load_factor = config->load_factor;
+    ht->min_load_factor = config->min_load_factor;
+
+    /* Initialize function ptrs withe defaults if NULL */
+    ht->hash_func = config->hash_func ? config->hash_func :
+        ht_hash_for_key_len(config->key_len, default_hash_func);
+    ht->seeded_hash_func = config->seeded_hash_func;
+    ht->seed = config->seed;
+    if (ht->seeded_hash_func && ht->seed == 0) {
+        ht->seed = ht_random_seed(ht);
+    }
+    ht->cmp_func = config->cmp_func ? config->cmp_func : default_cmp_func;
+    ht->free_key = config->free_key ? config->free_key : NULL;
+    ht->free_val = config->free_val ? config->free_val : NULL;
+
+    ht->buckets = alloc_buckets(ht->size);
+    if (ht->buckets == NULL) {
+        LOG_ERROR("%s", "Bucket allocation failed");
+        free(ht);
+        return NULL;
+    }
+
+    DBG_end("_init_ht");
+
+	return ht;
+}
+
+uint32_t ht_hash(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
+    CHECK_NULL(ht, "ht_hash: HashTab NULL", 0);
+    CHECK_NULL(key, "ht_hash: Key NULL", 0);
+
+    return compute_hash(ht, key, key_len);
+}
+
+void *ht_search(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
+    CHECK_NULL(ht,"ht_search: HashTab NULL", NULL);
+    CHECK_NULL(key, "HT_search: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search: Zero key length", NULL);
+
+    return ht_search_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+void *ht_search_hashed(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    HTnode *node;
+
+    DBG_info("ht_search_hashed");
+    CHECK_NULL(ht,"ht_search_hashed: HashTab NULL", NULL);
+    CHECK_NULL(key, "ht_search_hashed: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search_hashed: Zero key length", NULL);
+
+    node = find_node(
+        ht, &ht->buckets[bucket_index(hash_key, ht->size)], hash_key, key
+    );
+    if (node != NULL) {return node->value;}
+
+    DBG_info("ht_search_hashed: Key not found");
+    return NULL;
+}
+
+HTResult ht_insert(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        void *value
+) {
+    CHECK_NULL(ht, "ht_insert: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert: Zero key length", HT_INVALID_ARG);
+
+    return ht_insert_hashed(
+        ht,
+        key,
+        key_len,
+        compute_hash(ht, key, key_len),
+        value
+    );
+}
+
+HTResult ht_insert_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key,
+        void *value
+) {
+    HTResult result;
+    HTnode *node;
+
+    CHECK_NULL(ht, "ht_insert_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert_hashed: Zero key length", HT_INVALID_ARG);
+
+    if (ht_search_hashed(ht, key, key_len, hash_key)) {
+        return HT_KEY_EXISTS;
+    }
+
+    if (ht->active + 1 > ht->size * ht->load_factor) {
+        result = validate_size(ht->size, ht->size << 1);
+        if (result != HT_SUCCESS) {return result;}
+        result = resize(ht, ht->size << 1);
+        if (result != HT_SUCCESS) {return result;}
+    }
+
+    node = node_alloc(ht);
+    CHECK_NULL(node, "Node allocation failed", HT_MEM_ERROR);
+
+    node->hash_key = hash_key;
+    node->key = (void *)key;
+    node->value = value;
+    link_node(ht, &ht->buckets[bucket_index(hash_key, ht->size)], node);
+    ht->active++;
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Removes a key and its associated value from the hash table.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key to remove.
+ * @param key_len Length of the key in bytes.
+ * @return HT_SUCCESS on success,
+ *         HT_INVALID_ARG if inputs are invalid,
+ *         HT_KEY_NOT_FOUND if key isn’t found.
+ */
+HTResult ht_remove(HashTab *ht, const void *key, size_t key_len) {
+    CHECK_NULL(ht, "ht_remove: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove: Zero key length", HT_INVALID_ARG);
+
+    return ht_remove_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+HTResult ht_remove_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    CHECK_NULL(ht, "ht_remove_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove_hashed: Zero key length", HT_INVALID_ARG);
+
+    return remove_entry(ht, hash_key, key);
+}
+
+void ht_destroy(
+		HashTab *ht
+) {
+    HTslab *slab, *next_slab;
+    HTbucket *bucket;
+    HTnode *node;
+    uint32_t b, s;
+
+    if (ht == NULL) {
+        return;
+    }
+
+    if (ht->free_key || ht->free_val) {
+        for (b = 0; b < ht->size; b++) {
+            bucket = &ht->buckets[b];
+            for (s = 0; s < HEAD_SLOTS; s++) {
+                if (bucket->nodes[s] == NULL) {continue;}
+                if (ht->free_key) {ht->free_key(bucket->nodes[s]->key);}
+                if (ht->free_val) {ht->free_val(bucket->nodes[s]->value);}
+            }
+            for (node = bucket->overflow; node != NULL; node = node->next) {
+                if (ht->free_key) {ht->free_key(node->key);}
+                if (ht->free_val) {ht->free_val(node->value);}
+            }
+        }
+    }
+
+    /* nodes are released with their slabs */
+    for (slab = ht->slabs; slab != NULL; slab = next_slab) {
+        next_slab = slab->next;
+        free(slab);
+    }
+
+    free(ht->buckets);
+    ht->buckets = NULL;
+    ht->hash_func = NULL;
+    ht->cmp_func = NULL;
+    free(ht);
+}
+
+void ht_print(
+    const HashTab *ht,
+    void (*format_key)(void *key, char *buf, size_t buf_size),
+    void (*format_value)(void *value, char *buf, size_t buf_size)
+) {
+    char key_buffer[PRINT_BUFFER_SIZE];
+    char value_buffer[PRINT_BUFFER_SIZE];
+    const HTbucket *bucket;
+    const HTnode *node;
+    if (!ht || !format_key || !format_value) return;
+
+    printf("--- HashTab - size[%u] - entries[%u] - loadfct[%.2f] ---\n",
+           ht->size, ht->active, ht->load_factor);
+
+    for (uint32_t b = 0; b < ht->size; b++) {
+        bucket = &ht->buckets[b];
+        if (bucket->count == 0) {continue;}
+        printf("Bucket %u: count=%u\n", b, bucket->count);
+        for (uint32_t s = 0; s < HEAD_SLOTS; s++) {
+            node = bucket->nodes[s];
+            if (node == NULL) {continue;}
+            format_key(node->key, key_buffer, PRINT_BUFFER_SIZE);
+            format_value(node->value, value_buffer, PRINT_BUFFER_SIZE);
+            printf(
+                "  head %u: hash=%u, key=%s, value=%s\n",
+                s, node->hash_key, key_buffer, value_buffer
+            );
+        }
+        for (node = bucket->overflow; node != NULL; node = node->next) {
+            format_key(node->key, key_buffer, PRINT_BUFFER_SIZE);
+            format_value(node->value, value_buffer, PRINT_BUFFER_SIZE);
+            printf(
+                "  overflow: hash=%u, key=%s, value=%s\n",
+                node->hash_key, key_buffer, value_buffer
+            );
+        }
+    }
+}
+
+uint32_t ht_capacity(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_capacity: HashTab NULL", 0);
+    return ht->size;
+}
+
+uint32_t ht_max_psl(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_max_psl: HashTab NULL", 0);
+    return ht->max_psl;
+}
+
+HTResult ht_stats(
+        const HashTab *ht,
+        HTStats *out
+) {
+    uint32_t b, psl, slabs, bucket_psl;
+    uint64_t psl_sum;
+    const HTslab *slab;
+
+    CHECK_NULL(ht, "ht_stats: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(out, "ht_stats: HTStats NULL", HT_INVALID_ARG);
+
+    memset(out, 0, sizeof(*out));
+    out->capacity = ht->size;
+    out->active = ht->active;
+    out->load_factor = (float)ht->active / (float)ht->size;
+
+    /* psl is the position of an entry within its bucket */
+    psl_sum = 0;
+    for (b = 0; b < ht->size; b++) {
+        for (psl = 0; psl < ht->buckets[b].count; psl++) {
+            psl_sum += psl;
+            bucket_psl = psl < HT_STATS_PSL_BUCKETS ? psl : HT_STATS_PSL_BUCKETS - 1;
+            out->psl_histogram[bucket_psl]++;
+        }
+        if (ht->buckets[b].count > out->max_psl + 1) {
+            out->max_psl = ht->buckets[b].count - 1;
+        }
+    }
+    out->avg_psl = ht->active ? (double)psl_sum / ht->active : 0.0;
+
+    slabs = 0;
+    for (slab = ht->slabs; slab != NULL; slab = slab->next) {slabs++;}
+    out->bytes_allocated = sizeof(HashTab) +
+        (size_t)ht->size * sizeof(HTbucket) + (size_t)slabs * sizeof(HTslab);
+    STATS_export(ht, out);
+
+    return HT_SUCCESS;
+}
+
+/* --- utility functions ---------------------------------------------------- */
+
+/**
+ * @brief Links a node into a bucket, using a free head slot when available.
+ * @param ht Pointer to the hash table.
+ * @param bucket Pointer to the bucket head.
+ * @param node Pointer to the node, with its hash_key set.
+ */
+static void link_node(
+        HashTab *ht,
+        HTbucket *bucket,
+        HTnode *node
+) {
+    uint32_t s;
+
+    node->next = NULL;
+    for (s = 0; s < HEAD_SLOTS; s++) {
+        if (bucket->nodes[s] == NULL) {
+            bucket->tags[s] = HASH_TAG(node->hash_key);
+            bucket->nodes[s] = node;
+            break;
+        }
+    }
+    if (s == HEAD_SLOTS) {
+        node->next = bucket->overflow;
+        bucket->overflow = node;
+    }
+    if (bucket->count > ht->max_psl) {ht->max_psl = bucket->count;}
+    bucket->count++;
+}
+
+/**
+ * @brief Finds the node of a key in a bucket.
+ *
+ * The head tags filter the first HEAD_SLOTS nodes without dereferencing
+ * them, the overflow chain compares full hashes.
+ *
+ * @param ht Pointer to the hash table.
+ * @param bucket Pointer to the bucket head.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key.
+ * @return Pointer to the node, or NULL if not found.
+ */
+static HTnode *find_node(
+        const HashTab *ht,
+        const HTbucket *bucket,
+        uint32_t hash_key,
+        const void *key
+) {
+    uint16_t tag = HASH_TAG(hash_key);
+    HTnode *node;
+
+    for (uint32_t s = 0; s < HEAD_SLOTS; s++) {
+        node = bucket->nodes[s];
+        if (
+            node != NULL &&
+            bucket->tags[s] == tag &&
+            node->hash_key == hash_key &&
+            ht->cmp_func(node->key, key) == 0
+        ) {return node;}
+    }
+    for (node = bucket->overflow; node != NULL; node = node->next) {
+        if (node->hash_key == hash_key && ht->cmp_func(node->key, key) == 0) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Attempts to find and remove an entry with the given hash key and key.
+ *
+ * A head slot freed by the removal is refilled from the overflow chain so
+ * the head stays dense.
+ *
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key to remove.
+ * @return HT_SUCCESS if removed, HT_KEY_NOT_FOUND if not found.
+ */
+static HTResult remove_entry(
+        HashTab *ht,
+        uint32_t hash_key,
+        const void *key
+) {
+    HTbucket *bucket;
+    HTnode *node, **link;
+    uint32_t s;
+
+    bucket = &ht->buckets[bucket_index(hash_key, ht->size)];
+    node = find_node(ht, bucket, hash_key, key);
+    if (node == NULL) {return HT_KEY_NOT_FOUND;}
+
+    for (s = 0; s < HEAD_SLOTS && bucket->nodes[s] != node; s++) {}
+    if (s < HEAD_SLOTS) {
+        bucket->nodes[s] = bucket->overflow;
+        if (bucket->overflow != NULL) {
+            bucket->tags[s] = HASH_TAG(bucket->overflow->hash_key);
+            bucket->overflow = bucket->overflow->next;
+        }
+    } else {
+        for (link = &bucket->overflow; *link != node; link = &(*link)->next) {}
+        *link = node->next;
+    }
+    bucket->count--;
+
+    if (ht->free_key) {ht->free_key(node->key);}
+    if (ht->free_val) {ht->free_val(node->value);}
+    node_free(ht, node);
+    remove_table_update(ht);
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Updates the table state after removal, including resizing if needed.
+ * @param ht Pointer to the hash table.
+ */
+static void remove_table_update(
+        HashTab *ht
+) {
+    ht->active--;
+    if (ht->active < (float)ht->size * ht->min_load_factor && ht->size > 2) {
+        resize(ht, ht->size / 2);  /* Downsize if below min load factor */
+    }
+}
+
+/**
+ * @brief Resizes the bucket array, relinking the existing nodes.
+ * @param ht Pointer to the hash table.
+ * @param new_size New number of buckets (power of 2).
+ * @return HT_SUCCESS on success, HT_MEM_ERROR on failure.
+ */
+static HTResult resize(
+        HashTab *ht,
+        uint32_t new_size
+) {
+    HTbucket *old_buckets, *new_buckets;
+    HTnode *node, *next;
+    uint32_t old_size, b, s;
+    STATS_timer(start);
+
+    new_buckets = alloc_buckets(new_size);
+    CHECK_NULL(new_buckets, "Resize allocation failed", HT_MEM_ERROR);
+
+    old_buckets = ht->buckets;
+    old_size = ht->size;
+    ht->buckets = new_buckets;
+    ht->size = new_size;
+    ht->max_psl = 0;
+
+    for (b = 0; b < old_size; b++) {
+        for (s = 0; s < HEAD_SLOTS; s++) {
+            node = old_buckets[b].nodes[s];
+            if (node == NULL) {continue;}
+            link_node(ht, &ht->buckets[bucket_index(node->hash_key, new_size)], node);
+        }
+        for (node = old_buckets[b].overflow; node != NULL; node = next) {
+            next = node->next;
+            link_node(ht, &ht->buckets[bucket_index(node->hash_key, new_size)], node);
+        }
+    }
+
+    free(old_buckets);
+    STATS_resize(ht, start);
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Allocates a zeroed, cache line aligned array of bucket heads.
+ * @param size Number of buckets to allocate.
+ * @return Pointer to the bucket array, or NULL on failure.
+ */
+static HTbucket *alloc_buckets(
+        uint32_t size
+) {
+    void *mem;
+
+    if (posix_memalign(&mem, CACHE_LINE_SIZE, size * sizeof(HTbucket)) != 0) {
+        return NULL;
+    }
+    memset(mem, 0, size * sizeof(HTbucket));
+    return (HTbucket *)mem;
+}
+
+/**
+ * @brief Takes a node from the free list, carving a new slab when empty.
+ * @param ht Pointer to the hash table.
+ * @return Pointer to an uninitialised node, or NULL on failure.
+ */
+static HTnode *node_alloc(
+        HashTab *ht
+) {
+    HTslab *slab;
+    HTnode *node;
+    uint32_t i;
+
+    if (ht->free_nodes == NULL) {
+        slab = (HTslab *)malloc(sizeof(HTslab));
+        if (slab == NULL) {return NULL;}
+        slab->next = ht->slabs;
+        ht->slabs = slab;
+        /* thread in address order so consecutive inserts stay adjacent */
+        for (i = 0; i < SLAB_NODES - 1; i++) {
+            slab->nodes[i].next = &slab->nodes[i + 1];
+        }
+        slab->nodes[SLAB_NODES - 1].next = NULL;
+        ht->free_nodes = &slab->nodes[0];
+    }
+
+    node = ht->free_nodes;
+    ht->free_nodes = node->next;
+    return node;
+}
+
+/* Helper function to return a node to the free list */
+static void node_free(
+        HashTab *ht,
+        HTnode *node
+) {
+    node->key = NULL;
+    node->value = NULL;
+    node->next = ht->free_nodes;
+    ht->free_nodes = node;
+}
+
+/**
+ * @brief Computes the bucket of a hash key.
+ * @param hash_key Hash key value.
+ * @param m Number of buckets (must be a power of 2).
+ * @return Index into the bucket array.
+ */
+static inline uint32_t bucket_index(
+        uint32_t hash_key,
+        uint32_t m
+) {
+    return hash_key & (m - 1);
+}
+
+/* --- default functions ---------------------------------------------------- */
+
+/**
+ * @brief Hashes a key with the keyed hash when one is configured.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static inline uint32_t compute_hash(
+    const HashTab *ht,
+    const void *key,
+    size_t len
+) {
+    if (ht->seeded_hash_func) {
+        return ht->seeded_hash_func(key, len, ht->seed);
+    }
+    return ht->hash_func(key, len);
+}
+
+/**
+ * @brief Computes a default hash value for a key using the FNV-1a algorithm.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static uint32_t default_hash_func(
+    const void *key,
+    size_t len
+) {
+    const unsigned char *bytes_ptr = (const unsigned char *)key;
+    unsigned int hash = 2166136261u; // FNV offset basis
+    unsigned int fnv_prime = 16777619u; // FNV prime
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes_ptr[i];       // XOR with the byte
+        hash *= fnv_prime;          // Multiply by FNV prime
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Compares two integer keys for equality or ordering.
+ * @param a Pointer to the first key.
+ * @param b Pointer to the second key.
+ * @return Negative if a < b, 0 if a == b, positive if a > b.
+ */
+static int default_cmp_func(
+    const void *a,
+    const void *b
+) {
+    int int_a = *(const int *)a;
+    int int_b = *(const int *)b;
+    return (int_a > int_b) - (int_a < int_b);
+}
+
+/* --- validadation functions ---------------------------------------------- */
+
+/**
+ * @brief Validates load factor values for correctness.
+ *
+ * Chaining has no hard capacity, so load factors up to MAX_LOAD_FACTOR
+ * entries per bucket are accepted.
+ *
+ * @param load_factor Maximum load factor.
+ * @param min_load_factor Minimum load factor.
+ * @return HT_SUCCESS if valid, HT_INVALID_ARG if invalid.
+ */
+static inline HTResult validate_load_factors(
+    float load_factor,
+    float min_load_factor
+) {
+    if (load_factor <= 0 || load_factor > MAX_LOAD_FACTOR) {
+        LOG_ERROR("Invalid load_factor: %.2f", load_factor);
+        return HT_INVALID_ARG;
+    }
+    if (min_load_factor < 0 || min_load_factor >= load_factor) {
+        LOG_ERROR("Invalid min_load_factor: %.2f", min_load_factor);
+        return HT_INVALID_ARG;
+    }
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Validates a new size against constraints.
+ * @param size Current size of the table.
+ * @param new_size Proposed new number of buckets.
+ * @return HT_SUCCESS if valid, HT_FAILURE if invalid.
+ */
+static inline HTResult validate_size(
+    uint32_t size,
+    uint32_t new_size
+) {
+    (void)size;
+    if (new_size == 0 || new_size > UINT32_MAX / 2) {
+        LOG_ERROR("Invalid size: %u", new_size);
+        return HT_FAILURE;
+    }
+    return HT_SUCCESS;
+}
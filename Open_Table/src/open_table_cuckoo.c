@@ -0,0 +1,859 @@
+/**
+ * @file    open_table_cuckoo.c
+ * @brief   A bucketized cuckoo hashtable: every key has two candidate
+ *          buckets of four slots, so a lookup reads at most two buckets.
+ *          Buckets are two aligned cache lines, the hash codes and keys of
+ *          a bucket share the first, so a lookup scans one line per bucket
+ *          and reads the values line only on a hit.
+ *          Inserts into full buckets relocate entries along the shortest
+ *          eviction path found by a bounded breadth first search, and grow
+ *          the table when no such path exists.
+ * @author  J.W Moolman
+ * @date    2025-4-22
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "open_table.h"
+#include "ht_hash.h"
+#include "debug_hashtab.h"
+#include "stats_hashtab.h"
+
+#define PRINT_BUFFER_SIZE 1024
+#define CACHE_LINE_SIZE 64
+
+/** Number of slots in a bucket */
+#define BUCKET_SLOTS 4
+/** Maximum number of buckets visited by one eviction search */
+#define MAX_BFS_NODES 256
+
+#define SAFETY_CHECKS_ENABLED 1
+
+#if SAFETY_CHECKS_ENABLED
+#define LOG_ERROR(fmt, ...) \
+    fprintf(stderr, "%s:%d " fmt "\n", __FILE__, __LINE__, __VA_ARGS__)
+#else
+#define LOG_ERROR(fmt, ...) ((void)0)
+#endif
+
+#define GET_ARG_COUNT(...) GET_ARG_COUNT_HELPER(__VA_ARGS__, 3, 2, 1)
+#define GET_ARG_COUNT_HELPER(_1, _2, _3, count, ...) count
+
+#define CHECK_CONDITION_2(cond, return_val) \
+    do { if (!(cond)) return (return_val); } while (0)
+
+#define CHECK_CONDITION_3(cond, msg, return_val) \
+    do { \
+        if (!(cond)) { \
+            LOG_ERROR("%s", msg); \
+            return (return_val); \
+        } \
+    } while (0)
+
+#define CHECK_CONDITION(...) \
+    _CHECK_CONDITION(GET_ARG_COUNT(__VA_ARGS__), __VA_ARGS__)
+
+#define _CHECK_CONDITION(N, ...) \
+    _CHECK_CONDITION_IMPL(N, __VA_ARGS__)
+
+#define _CHECK_CONDITION_IMPL(N, ...) CHECK_CONDITION_##N(__VA_ARGS__)
+
+#define CHECK_NULL(...) CHECK_CONDITION(__VA_ARGS__)
+#define CHECK_RANGE(val, min, max, ...) \
+    CHECK_CONDITION((val) >= (min) && (val) <= (max), __VA_ARGS__)
+#define CHECK_NONZERO(val, ...) CHECK_CONDITION((val) != 0, __VA_ARGS__)
+
+/* A set associative bucket, a slot is empty when its key is NULL.
+ * Padded to two cache lines: hash codes and keys in the first line,
+ * values in the second. */
+typedef struct {
+    uint32_t hash_keys[BUCKET_SLOTS]; /* Hash codes to find the alternate */
+    void *keys[BUCKET_SLOTS];         /* Pointers to key data             */
+    uint8_t reserved[CACHE_LINE_SIZE - BUCKET_SLOTS *
+                     (sizeof(uint32_t) + sizeof(void *))];
+    void *values[BUCKET_SLOTS];       /* Pointers to value data           */
+    uint8_t reserved2[CACHE_LINE_SIZE - BUCKET_SLOTS * sizeof(void *)];
+} HTbucket;
+
+/* A node of the eviction search, each names one bucket on a path */
+typedef struct {
+    uint32_t bucket;  /* Bucket index                                */
+    int32_t parent;   /* Node whose entry moves here, -1 for a root  */
+    uint32_t slot;    /* Slot of that entry in the parent bucket     */
+} BFSnode;
+
+/* a hash table container */
+struct hashtab {
+    HTbucket *buckets;   /* Array of buckets                               */
+    uint32_t num_buckets;/* Number of buckets (power of 2)                 */
+    uint32_t size;       /* Current size (capacity) in slots               */
+    uint32_t active;     /* Number of non-empty entries (active)           */
+    uint32_t max_psl;    /* 1 once any entry lives in its alternate bucket */
+
+    float load_factor;       /* Max load factor before resizing            */
+    float min_load_factor;   /* Min load factor to consider downsizing     */
+
+    uint32_t (*hash_func)(const void *key, size_t len);
+    uint32_t (*seeded_hash_func)(const void *key, size_t len, uint64_t seed);
+    uint64_t seed;
+	int (*cmp_func)(const void *a, const void *b);
+
+    void (*free_key)(void *k);
+    void (*free_val)(void *v);
+
+    STATS_fields
+};
+
+/* --- function prototypes -------------------------------------------------- */
+
+static inline uint32_t compute_hash(
+        const HashTab *ht, const void *key, size_t len
+);
+static uint32_t default_hash_func(
+        const void *key, size_t len
+);
+static int default_cmp_func(
+        const void *a, const void *b
+);
+static HTResult insert_entry(
+        HashTab *ht, uint32_t hash_key, void *key, void *value
+);
+static int find_eviction_path(
+        const HashTab *ht, uint32_t b1, uint32_t b2,
+        BFSnode *nodes, uint32_t *free_slot
+);
+static HTResult remove_entry(
+        HashTab *ht, uint32_t hash_key, const void *key
+);
+static void remove_table_update(
+        HashTab *ht
+);
+static HTResult resize(
+        HashTab *ht, uint32_t new_num_buckets,
+        uint32_t hash_key, void *key, void *value
+);
+static HTbucket *alloc_buckets(
+        uint32_t num_buckets
+);
+static void free_entry(
+        HashTab *ht, HTbucket *bucket, uint32_t slot
+);
+static inline int find_slot(
+        const HashTab *ht, const HTbucket *bucket,
+        uint32_t hash_key, const void *key
+);
+static inline int empty_slot(
+        const HTbucket *bucket
+);
+static inline uint32_t primary_bucket(
+        uint32_t hash_key, uint32_t m
+);
+static inline uint32_t alternate_bucket(
+        uint32_t index, uint32_t hash_key, uint32_t m
+);
+
+static inline HTResult validate_load_factors(
+        float load_factor, float min_load_factor
+);
+static inline HTResult validate_size(
+        uint32_t size, uint32_t new_size
+);
+/* --- hash table interface ------------------------------------------------- */
+
+HashTab *ht_create(
+    const HTConfig *config
+) {
+    HashTab *ht;
+
+    DBG_start("init_ht_");
+    CHECK_NULL(config, "HTConfig NULL", NULL);
+
+    if (
+        validate_load_factors(config->load_factor, config->min_load_factor) != HT_SUCCESS
+    ) {return NULL;}
+
+    ht = (HashTab *)malloc(sizeof(HashTab));
+    CHECK_NULL(ht, "Hashtable allocation failed", NULL);
+
+    /* Initialize load tracking variables, starting with a single bucket */
+    ht->num_buckets = 1;
+    ht->size = BUCKET_SLOTS;
+    ht->active = 0;
+    ht->max_psl = 0;
+    STATS_init(ht);
+
+    /* Initialize load factors with defaults if zero */
+    ht->load_factor = config->load_factor;
+    ht->min_load_factor = config->min_load_factor;
+
+    /* Initialize function ptrs withe defaults if NULL */
+    ht->hash_func = config->hash_func ? config->hash_func :
+        ht_hash_for_key_len(config->key_len, default_hash_func);
+    ht->seeded_hash_func = config->seeded_hash_func;
+    ht->seed = config->seed;
+    if (ht->seeded_hash_func && ht->seed == 0) {
+        ht->seed = ht_random_seed(ht);
+    }
+    ht->cmp_func = config->cmp_func ? config->cmp_func : default_cmp_func;
+    ht->free_key = config->free_key ? config->free_key : NULL;
+    ht->free_val = config->free_val ? config->free_val : NULL;
+
+    ht->buckets = alloc_buckets(ht->num_buckets);
+    if (ht->buckets == NULL) {
+        LOG_ERROR("%s", "Bucket allocation failed");
+        free(ht);
+        return NULL;
+    }
+
+    DBG_end("_init_ht");
+
+	return ht;
+}
+
+uint32_t ht_hash(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
+    CHECK_NULL(ht, "ht_hash: HashTab NULL", 0);
+    CHECK_NULL(key, "ht_hash: Key NULL", 0);
+
+    return compute_hash(ht, key, key_len);
+}
+
+void *ht_search(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
+    CHECK_NULL(ht,"ht_search: HashTab NULL", NULL);
+    CHECK_NULL(key, "HT_search: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search: Zero key length", NULL);
+
+    return ht_search_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+void *ht_search_hashed(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    uint32_t b1, b2;
+    int s;
+
+    DBG_info("ht_search_hashed");
+    CHECK_NULL(ht,"ht_search_hashed: HashTab NULL", NULL);
+    CHECK_NULL(key, "ht_search_hashed: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search_hashed: Zero key length", NULL);
+
+    b1 = primary_bucket(hash_key, ht->num_buckets);
+    s = find_slot(ht, &ht->buckets[b1], hash_key, key);
+    if (s >= 0) {return ht->buckets[b1].values[s];}
+
+    b2 = alternate_bucket(b1, hash_key, ht->num_buckets);
+    s = find_slot(ht, &ht->buckets[b2], hash_key, key);
+    if (s >= 0) {return ht->buckets[b2].values[s];}
+
+    DBG_info("ht_search_hashed: Key not found");
+    return NULL;
+}
+
+HTResult ht_insert(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        void *value
+) {
+    CHECK_NULL(ht, "ht_insert: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert: Zero key length", HT_INVALID_ARG);
+
+    return ht_insert_hashed(
+        ht,
+        key,
+        key_len,
+        compute_hash(ht, key, key_len),
+        value
+    );
+}
+
+HTResult ht_insert_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key,
+        void *value
+) {
+    CHECK_NULL(ht, "ht_insert_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert_hashed: Zero key length", HT_INVALID_ARG);
+
+    if (ht_search_hashed(ht, key, key_len, hash_key)) {
+        return HT_KEY_EXISTS;
+    }
+
+    /* grow at most once per insert, the new key moves along with the
+     * entries, and a key that still finds no bucket leaves the table as
+     * it was: doubling never separates keys with identical hashes */
+    if (ht->active + 1 > ht->size * ht->load_factor) {
+        return resize(ht, ht->num_buckets << 1, hash_key, (void *)key, value);
+    }
+    if (insert_entry(ht, hash_key, (void *)key, value) == HT_SUCCESS) {
+        return HT_SUCCESS;
+    }
+    return resize(ht, ht->num_buckets << 1, hash_key, (void *)key, value);
+}
+
+/**
+ * @brief Removes a key and its associated value from the hash table.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key to remove.
+ * @param key_len Length of the key in bytes.
+ * @return HT_SUCCESS on success,
+ *         HT_INVALID_ARG if inputs are invalid,
+ *         HT_KEY_NOT_FOUND if key isn’t found.
+ */
+HTResult ht_remove(HashTab *ht, const void *key, size_t key_len) {
+    CHECK_NULL(ht, "ht_remove: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove: Zero key length", HT_INVALID_ARG);
+
+    return ht_remove_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+HTResult ht_remove_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    CHECK_NULL(ht, "ht_remove_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove_hashed: Zero key length", HT_INVALID_ARG);
+
+    return remove_entry(ht, hash_key, key);
+}
+
+void ht_destroy(
+		HashTab *ht
+) {
+    uint32_t b, s;
+
+    if (ht == NULL) {
+        return;
+    }
+
+    for (b = 0; b < ht->num_buckets; b++) {
+        for (s = 0; s < BUCKET_SLOTS; s++) {
+            if (ht->buckets[b].keys[s] != NULL) {
+                free_entry(ht, &ht->buckets[b], s);
+            }
+        }
+    }
+
+    free(ht->buckets);
+    ht->buckets = NULL;
+    ht->hash_func = NULL;
+    ht->cmp_func = NULL;
+    free(ht);
+}
+
+void ht_print(
+    const HashTab *ht,
+    void (*format_key)(void *key, char *buf, size_t buf_size),
+    void (*format_value)(void *value, char *buf, size_t buf_size)
+) {
+    char key_buffer[PRINT_BUFFER_SIZE];
+    char value_buffer[PRINT_BUFFER_SIZE];
+    const HTbucket *bucket;
+    if (!ht || !format_key || !format_value) return;
+
+    printf("--- HashTab - size[%u] - entries[%u] - loadfct[%.2f] ---\n",
+           ht->size, ht->active, ht->load_factor);
+
+    for (uint32_t b = 0; b < ht->num_buckets; b++) {
+        bucket = &ht->buckets[b];
+        for (uint32_t s = 0; s < BUCKET_SLOTS; s++) {
+            if (bucket->keys[s] == NULL) {continue;}
+            format_key(bucket->keys[s], key_buffer, PRINT_BUFFER_SIZE);
+            format_value(bucket->values[s], value_buffer, PRINT_BUFFER_SIZE);
+            printf(
+                "Bucket %u slot %u: hash=%u, alt=%u, key=%s, value=%s\n",
+                b, s, bucket->hash_keys[s],
+                primary_bucket(bucket->hash_keys[s], ht->num_buckets) != b,
+                key_buffer, value_buffer
+            );
+        }
+    }
+}
+
+uint32_t ht_capacity(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_capacity: HashTab NULL", 0);
+    return ht->size;
+}
+
+uint32_t ht_max_psl(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_max_psl: HashTab NULL", 0);
+    return ht->max_psl;
+}
+
+HTResult ht_stats(
+        const HashTab *ht,
+        HTStats *out
+) {
+    uint32_t b, s, psl;
+    uint64_t psl_sum;
+
+    CHECK_NULL(ht, "ht_stats: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(out, "ht_stats: HTStats NULL", HT_INVALID_ARG);
+
+    memset(out, 0, sizeof(*out));
+    out->capacity = ht->size;
+    out->active = ht->active;
+    out->load_factor = (float)ht->active / (float)ht->size;
+
+    /* psl is 0 for entries in their primary bucket, 1 in the alternate */
+    psl_sum = 0;
+    for (b = 0; b < ht->num_buckets; b++) {
+        for (s = 0; s < BUCKET_SLOTS; s++) {
+            if (ht->buckets[b].keys[s] == NULL) {continue;}
+            psl = primary_bucket(ht->buckets[b].hash_keys[s], ht->num_buckets) != b;
+            psl_sum += psl;
+            if (psl > out->max_psl) {out->max_psl = psl;}
+            out->psl_histogram[psl]++;
+        }
+    }
+    out->avg_psl = ht->active ? (double)psl_sum / ht->active : 0.0;
+    out->bytes_allocated = sizeof(HashTab) +
+        (size_t)ht->num_buckets * sizeof(HTbucket);
+    STATS_export(ht, out);
+
+    return HT_SUCCESS;
+}
+
+/* --- utility functions ---------------------------------------------------- */
+
+/**
+ * @brief Inserts a key-value pair, relocating entries if both buckets are full.
+ *
+ * The entries along the eviction path each move to their alternate bucket,
+ * starting at the end of the path so every move targets a free slot.
+ *
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key data.
+ * @param value Pointer to the value data.
+ * @return HT_SUCCESS on success, HT_FAILURE if no eviction path was found.
+ */
+static HTResult insert_entry(
+        HashTab *ht,
+        uint32_t hash_key,
+        void *key,
+        void *value
+) {
+    BFSnode nodes[MAX_BFS_NODES];
+    HTbucket *dst, *src;
+    uint32_t b1, b2, slot;
+    int32_t n;
+
+    b1 = primary_bucket(hash_key, ht->num_buckets);
+    b2 = alternate_bucket(b1, hash_key, ht->num_buckets);
+
+    n = find_eviction_path(ht, b1, b2, nodes, &slot);
+    if (n < 0) {return HT_FAILURE;}
+
+    /* walk the path back to its root, each move frees the parent's slot */
+    while (nodes[n].parent >= 0) {
+        dst = &ht->buckets[nodes[n].bucket];
+        src = &ht->buckets[nodes[nodes[n].parent].bucket];
+        dst->hash_keys[slot] = src->hash_keys[nodes[n].slot];
+        dst->keys[slot] = src->keys[nodes[n].slot];
+        dst->values[slot] = src->values[nodes[n].slot];
+        if (primary_bucket(dst->hash_keys[slot], ht->num_buckets) != nodes[n].bucket) {
+            ht->max_psl = 1;
+        }
+        slot = nodes[n].slot;
+        n = nodes[n].parent;
+    }
+
+    dst = &ht->buckets[nodes[n].bucket];
+    dst->hash_keys[slot] = hash_key;
+    dst->keys[slot] = key;
+    dst->values[slot] = value;
+    if (nodes[n].bucket != b1) {ht->max_psl = 1;}
+    ht->active++;
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Breadth first search for the nearest bucket with a free slot.
+ *
+ * Starting from both candidate buckets, each visited bucket expands to the
+ * alternate buckets of its four entries. A bucket already on the path to a
+ * node is not expanded again, so executing a path never moves an entry
+ * twice.
+ *
+ * @param ht Pointer to the hash table.
+ * @param b1 Primary bucket of the new key.
+ * @param b2 Alternate bucket of the new key.
+ * @param nodes Output array of MAX_BFS_NODES search nodes.
+ * @param free_slot Output free slot in the bucket of the returned node.
+ * @return Index of the node holding the free slot, -1 if none was found.
+ */
+static int find_eviction_path(
+        const HashTab *ht,
+        uint32_t b1,
+        uint32_t b2,
+        BFSnode *nodes,
+        uint32_t *free_slot
+) {
+    const HTbucket *bucket;
+    uint32_t head, tail, s, next;
+    int32_t p, slot;
+
+    nodes[0] = (BFSnode){b1, -1, 0};
+    nodes[1] = (BFSnode){b2, -1, 0};
+    tail = (b1 == b2) ? 1 : 2;
+
+    for (head = 0; head < tail; head++) {
+        bucket = &ht->buckets[nodes[head].bucket];
+        slot = empty_slot(bucket);
+        if (slot >= 0) {
+            *free_slot = (uint32_t)slot;
+            return (int)head;
+        }
+        for (s = 0; s < BUCKET_SLOTS && tail < MAX_BFS_NODES; s++) {
+            next = alternate_bucket(
+                nodes[head].bucket, bucket->hash_keys[s], ht->num_buckets
+            );
+            for (p = (int32_t)head; p >= 0; p = nodes[p].parent) {
+                if (nodes[p].bucket == next) {break;}
+            }
+            if (p >= 0) {continue;}
+            nodes[tail++] = (BFSnode){next, (int32_t)head, s};
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Attempts to find and remove an entry with the given hash key and key.
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key to remove.
+ * @return HT_SUCCESS if removed, HT_KEY_NOT_FOUND if not found.
+ */
+static HTResult remove_entry(
+        HashTab *ht,
+        uint32_t hash_key,
+        const void *key
+) {
+    uint32_t b;
+    int s;
+
+    b = primary_bucket(hash_key, ht->num_buckets);
+    s = find_slot(ht, &ht->buckets[b], hash_key, key);
+    if (s < 0) {
+        b = alternate_bucket(b, hash_key, ht->num_buckets);
+        s = find_slot(ht, &ht->buckets[b], hash_key, key);
+        if (s < 0) {return HT_KEY_NOT_FOUND;}
+    }
+
+    free_entry(ht, &ht->buckets[b], (uint32_t)s);
+    remove_table_update(ht);
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Updates the table state after removal, including resizing if needed.
+ * @param ht Pointer to the hash table.
+ */
+static void remove_table_update(
+        HashTab *ht
+) {
+    ht->active--;
+    if (
+        ht->active < (float)ht->size * ht->min_load_factor &&
+        ht->num_buckets > 1
+    ) {
+        resize(ht, ht->num_buckets / 2, 0, NULL, NULL);  /* Downsize if below min load factor */
+    }
+}
+
+/**
+ * @brief Resizes the hash table and optionally inserts one more entry.
+ *
+ * When an entry finds no eviction path in the new table the old table is
+ * kept unchanged, so a failed insert never leaves the table grown.
+ *
+ * @param ht Pointer to the hash table.
+ * @param new_num_buckets New number of buckets (power of 2).
+ * @param hash_key Precomputed hash value of the pending key.
+ * @param key Pending key to insert after the entries, NULL for none.
+ * @param value Value of the pending key.
+ * @return HT_SUCCESS on success, HT_MEM_ERROR or HT_FAILURE on failure.
+ */
+static HTResult resize(
+        HashTab *ht,
+        uint32_t new_num_buckets,
+        uint32_t hash_key,
+        void *key,
+        void *value
+) {
+    HTbucket *old_buckets;
+    uint32_t old_num_buckets, old_active, old_max_psl, b, s;
+    HTResult result;
+    STATS_timer(start);
+
+    result = validate_size(ht->size, new_num_buckets * BUCKET_SLOTS);
+    if (result != HT_SUCCESS) {return result;}
+
+    old_buckets = ht->buckets;
+    old_num_buckets = ht->num_buckets;
+    old_active = ht->active;
+    old_max_psl = ht->max_psl;
+
+    ht->buckets = alloc_buckets(new_num_buckets);
+    if (ht->buckets == NULL) {
+        LOG_ERROR("%s", "Resize allocation failed");
+        ht->buckets = old_buckets;
+        return HT_MEM_ERROR;
+    }
+    ht->num_buckets = new_num_buckets;
+    ht->size = new_num_buckets * BUCKET_SLOTS;
+    ht->active = 0;
+    ht->max_psl = 0;
+
+    result = HT_SUCCESS;
+    for (b = 0; b < old_num_buckets && result == HT_SUCCESS; b++) {
+        for (s = 0; s < BUCKET_SLOTS && result == HT_SUCCESS; s++) {
+            if (old_buckets[b].keys[s] == NULL) {continue;}
+            result = insert_entry(
+                ht,
+                old_buckets[b].hash_keys[s],
+                old_buckets[b].keys[s],
+                old_buckets[b].values[s]
+            );
+        }
+    }
+    if (result == HT_SUCCESS && key) {
+        result = insert_entry(ht, hash_key, key, value);
+    }
+    if (result == HT_SUCCESS) {
+        free(old_buckets);
+        STATS_resize(ht, start);
+        return HT_SUCCESS;
+    }
+
+    /* the old entries are untouched, restore the old table */
+    free(ht->buckets);
+    ht->buckets = old_buckets;
+    ht->num_buckets = old_num_buckets;
+    ht->size = old_num_buckets * BUCKET_SLOTS;
+    ht->active = old_active;
+    ht->max_psl = old_max_psl;
+    return HT_FAILURE;
+}
+
+/**
+ * @brief Allocates a zeroed, cache line aligned array of buckets.
+ * @param num_buckets Number of buckets to allocate.
+ * @return Pointer to the bucket array, or NULL on failure.
+ */
+static HTbucket *alloc_buckets(
+        uint32_t num_buckets
+) {
+    void *mem;
+
+    if (posix_memalign(&mem, CACHE_LINE_SIZE, num_buckets * sizeof(HTbucket)) != 0) {
+        return NULL;
+    }
+    memset(mem, 0, num_buckets * sizeof(HTbucket));
+    return (HTbucket *)mem;
+}
+
+/**
+ * @brief Frees the memory associated with a slot and marks it empty.
+ * @param ht Pointer to the hash table.
+ * @param bucket Pointer to the bucket holding the slot.
+ * @param slot Index of the slot within the bucket.
+ */
+static void free_entry(
+        HashTab *ht,
+        HTbucket *bucket,
+        uint32_t slot
+) {
+    if (ht->free_key) {ht->free_key(bucket->keys[slot]);}
+    if (ht->free_val) {ht->free_val(bucket->values[slot]);}
+    bucket->hash_keys[slot] = 0;
+    bucket->keys[slot] = NULL;
+    bucket->values[slot] = NULL;
+}
+
+/* Helper function to find a key in a bucket, returns the slot or -1 */
+static inline int find_slot(
+        const HashTab *ht,
+        const HTbucket *bucket,
+        uint32_t hash_key,
+        const void *key
+) {
+    for (int s = 0; s < BUCKET_SLOTS; s++) {
+        if (
+            bucket->hash_keys[s] == hash_key &&
+            bucket->keys[s] != NULL &&
+            ht->cmp_func(bucket->keys[s], key) == 0
+        ) {return s;}
+    }
+    return -1;
+}
+
+/* Helper function to find a free slot in a bucket, returns the slot or -1 */
+static inline int empty_slot(
+        const HTbucket *bucket
+) {
+    for (int s = 0; s < BUCKET_SLOTS; s++) {
+        if (bucket->keys[s] == NULL) {return s;}
+    }
+    return -1;
+}
+
+/**
+ * @brief Computes the primary bucket of a hash key.
+ * @param hash_key Hash key value.
+ * @param m Number of buckets (must be a power of 2).
+ * @return Index into the bucket array.
+ */
+static inline uint32_t primary_bucket(
+        uint32_t hash_key,
+        uint32_t m
+) {
+    return hash_key & (m - 1);
+}
+
+/**
+ * @brief Computes the other candidate bucket of an entry.
+ *
+ * The offset only depends on the hash, so applying it to either candidate
+ * yields the other one. It is forced odd to differ from the index whenever
+ * there is more than one bucket.
+ *
+ * @param index Current bucket of the entry.
+ * @param hash_key Hash key value.
+ * @param m Number of buckets (must be a power of 2).
+ * @return Index into the bucket array.
+ */
+static inline uint32_t alternate_bucket(
+        uint32_t index,
+        uint32_t hash_key,
+        uint32_t m
+) {
+    uint32_t h = hash_key * 0x9E3779B1u;
+    h ^= h >> 15;
+    return (index ^ (h | 1u)) & (m - 1);
+}
+
+/* --- default functions ---------------------------------------------------- */
+
+/**
+ * @brief Hashes a key with the keyed hash when one is configured.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static inline uint32_t compute_hash(
+    const HashTab *ht,
+    const void *key,
+    size_t len
+) {
+    if (ht->seeded_hash_func) {
+        return ht->seeded_hash_func(key, len, ht->seed);
+    }
+    return ht->hash_func(key, len);
+}
+
+/**
+ * @brief Computes a default hash value for a key using the FNV-1a algorithm.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static uint32_t default_hash_func(
+    const void *key,
+    size_t len
+) {
+    const unsigned char *bytes_ptr = (const unsigned char *)key;
+    unsigned int hash = 2166136261u; // FNV offset basis
+    unsigned int fnv_prime = 16777619u; // FNV prime
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes_ptr[i];       // XOR with the byte
+        hash *= fnv_prime;          // Multiply by FNV prime
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Compares two integer keys for equality or ordering.
+ * @param a Pointer to the first key.
+ * @param b Pointer to the second key.
+ * @return Negative if a < b, 0 if a == b, positive if a > b.
+ */
+static int default_cmp_func(
+    const void *a,
+    const void *b
+) {
+    int int_a = *(const int *)a;
+    int int_b = *(const int *)b;
+    return (int_a > int_b) - (int_a < int_b);
+}
+
+/* --- validadation functions ---------------------------------------------- */
+
+/**
+ * @brief Validates load factor values for correctness.
+ * @param load_factor Maximum load factor.
+ * @param min_load_factor Minimum load factor.
+ * @return HT_SUCCESS if valid, HT_INVALID_ARG if invalid.
+ */
+static inline HTResult validate_load_factors(
+    float load_factor,
+    float min_load_factor
+) {
+    if (load_factor <= 0 || load_factor > 1) {
+        LOG_ERROR("Invalid load_factor: %.2f", load_factor);
+        return HT_INVALID_ARG;
+    }
+    if (min_load_factor < 0 || min_load_factor >= load_factor) {
+        LOG_ERROR("Invalid min_load_factor: %.2f", min_load_factor);
+        return HT_INVALID_ARG;
+    }
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Validates a new size against constraints.
+ * @param size Current size of the table.
+ * @param new_size Proposed new size in slots.
+ * @return HT_SUCCESS if valid, HT_FAILURE if invalid.
+ */
+static inline HTResult validate_size(
+    uint32_t size,
+    uint32_t new_size
+) {
+    (void)size;
+    if (new_size == 0 || new_size > UINT32_MAX / 2) {
+        LOG_ERROR("Invalid size: %u", new_size);
+        return HT_FAILURE;
+    }
+    return HT_SUCCESS;
+}
@@ -0,0 +1,773 @@
+/**
+ * @file    open_table_hopscotch.c
+ * @brief   A hopscotch hashtable: every entry lives within HOP_RANGE slots
+ *          of its home slot, and each home slot keeps a bitmap of the
+ *          neighbours holding its entries, so a lookup only compares the
+ *          marked slots of a fixed window.
+ * @author  J.W Moolman
+ * @date    2025-4-22
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "open_table.h"
+#include "ht_hash.h"
+#include "debug_hashtab.h"
+#include "stats_hashtab.h"
+
+#define PRINT_BUFFER_SIZE 1024
+
+/** Neighbourhood size, one bit of hop_info per slot */
+#define HOP_RANGE 32
+/** Maximum distance scanned for a free slot before resizing */
+#define ADD_RANGE 512
+
+#define SAFETY_CHECKS_ENABLED 1
+
+#if SAFETY_CHECKS_ENABLED
+#define LOG_ERROR(fmt, ...) \
+    fprintf(stderr, "%s:%d " fmt "\n", __FILE__, __LINE__, __VA_ARGS__)
+#else
+#define LOG_ERROR(fmt, ...) ((void)0)
+#endif
+
+#define GET_ARG_COUNT(...) GET_ARG_COUNT_HELPER(__VA_ARGS__, 3, 2, 1)
+#define GET_ARG_COUNT_HELPER(_1, _2, _3, count, ...) count
+
+#define CHECK_CONDITION_2(cond, return_val) \
+    do { if (!(cond)) return (return_val); } while (0)
+
+#define CHECK_CONDITION_3(cond, msg, return_val) \
+    do { \
+        if (!(cond)) { \
+            LOG_ERROR("%s", msg); \
+            return (return_val); \
+        } \
+    } while (0)
+
+#define CHECK_CONDITION(...) \
+    _CHECK_CONDITION(GET_ARG_COUNT(__VA_ARGS__), __VA_ARGS__)
+
+#define _CHECK_CONDITION(N, ...) \
+    _CHECK_CONDITION_IMPL(N, __VA_ARGS__)
+
+#define _CHECK_CONDITION_IMPL(N, ...) CHECK_CONDITION_##N(__VA_ARGS__)
+
+#define CHECK_NULL(...) CHECK_CONDITION(__VA_ARGS__)
+#define CHECK_RANGE(val, min, max, ...) \
+    CHECK_CONDITION((val) >= (min) && (val) <= (max), __VA_ARGS__)
+#define CHECK_NONZERO(val, ...) CHECK_CONDITION((val) != 0, __VA_ARGS__)
+
+/* A slot, empty when its key is NULL */
+struct htentry {
+    uint32_t hash_key;   /* Cached hash code for quicker comparison      */
+    uint32_t hop_info;   /* Bit i set: slot home+i holds an entry of ours */
+    void *key;           /* Pointer to key data                          */
+    void *value;         /* Pointer to value data                        */
+};
+
+/* a hash table container */
+struct hashtab {
+    HTentry *table;      /* Underlying array of entries (slots)          */
+    uint32_t size;       /* Current size (capacity) of the table         */
+    uint32_t active;     /* Number of non-empty entries (active)         */
+    uint32_t max_psl;    /* Longest distance of an entry from its home   */
+
+    float load_factor;       /* Max load factor before resizing          */
+    float min_load_factor;   /* Min load factor to consider downsizing   */
+
+    uint32_t (*hash_func)(const void *key, size_t len);
+    uint32_t (*seeded_hash_func)(const void *key, size_t len, uint64_t seed);
+    uint64_t seed;
+	int (*cmp_func)(const void *a, const void *b);
+
+    void (*free_key)(void *k);
+    void (*free_val)(void *v);
+
+    STATS_fields
+};
+
+/* --- function prototypes -------------------------------------------------- */
+
+static inline uint32_t compute_hash(
+        const HashTab *ht, const void *key, size_t len
+);
+static uint32_t default_hash_func(
+        const void *key, size_t len
+);
+static int default_cmp_func(
+        const void *a, const void *b
+);
+static HTResult insert_entry(
+        HashTab *ht, uint32_t hash_key, void *key, void *value
+);
+static int hop_closer(
+        HashTab *ht, uint32_t *free_index
+);
+static HTResult remove_entry(
+        HashTab *ht, uint32_t hash_key, const void *key
+);
+static void remove_table_update(
+        HashTab *ht
+);
+static int neighbourhood_shared(
+        HashTab *ht, uint32_t hash_key
+);
+static HTResult resize(
+        HashTab *ht, uint32_t new_size, uint32_t hash_key, void *key, void *value
+);
+static void free_entry(
+        HashTab *ht, HTentry *entry
+);
+static inline int32_t find_index(
+        const HashTab *ht, uint32_t hash_key, const void *key
+);
+static inline uint32_t probe_func(
+        uint32_t k, uint32_t i, uint32_t m
+);
+
+static inline HTResult validate_load_factors(
+        float load_factor, float min_load_factor
+);
+static inline HTResult validate_size(
+        uint32_t size, uint32_t new_size
+);
+/* --- hash table interface ------------------------------------------------- */
+
+HashTab *ht_create(
+    const HTConfig *config
+) {
+    HashTab *ht;
+
+    DBG_start("init_ht_");
+    CHECK_NULL(config, "HTConfig NULL", NULL);
+
+    if (
+        validate_load_factors(config->load_factor, config->min_load_factor) != HT_SUCCESS
+    ) {return NULL;}
+
+    ht = (HashTab *)malloc(sizeof(HashTab));
+    CHECK_NULL(ht, "Hashtable allocation failed", NULL);
+
+    /* Initialize load tracking variables */
+    ht->size = 2;
+    ht->active = 0;
+    ht->max_psl = 0;
+    STATS_init(ht);
+
+    /* Initialize load factors with defaults if zero */
+    ht->load_factor = config->load_factor;
+    ht->min_load_factor = config->min_load_factor;
+
+    /* Initialize function ptrs withe defaults if NULL */
+    ht->hash_func = config->hash_func ? config->hash_func :
+        ht_hash_for_key_len(config->key_len, default_hash_func);
+    ht->seeded_hash_func = config->seeded_hash_func;
+    ht->seed = config->seed;
+    if (ht->seeded_hash_func && ht->seed == 0) {
+        ht->seed = ht_random_seed(ht);
+    }
+    ht->cmp_func = config->cmp_func ? config->cmp_func : default_cmp_func;
+    ht->free_key = config->free_key ? config->free_key : NULL;
+    ht->free_val = config->free_val ? config->free_val : NULL;
+
+    ht->table = (HTentry *)calloc(ht->size, sizeof(HTentry));
+    if (ht->table == NULL) {
+        LOG_ERROR("%s", "Hashtable allocation failed");
+        free(ht);
+        return NULL;
+    }
+
+    DBG_end("_init_ht");
+
+	return ht;
+}
+
+uint32_t ht_hash(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
+    CHECK_NULL(ht, "ht_hash: HashTab NULL", 0);
+    CHECK_NULL(key, "ht_hash: Key NULL", 0);
+
+    return compute_hash(ht, key, key_len);
+}
+
+void *ht_search(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len
+) {
+    CHECK_NULL(ht,"ht_search: HashTab NULL", NULL);
+    CHECK_NULL(key, "HT_search: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search: Zero key length", NULL);
+
+    return ht_search_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+void *ht_search_hashed(
+        const HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    int32_t index;
+
+    DBG_info("ht_search_hashed");
+    CHECK_NULL(ht,"ht_search_hashed: HashTab NULL", NULL);
+    CHECK_NULL(key, "ht_search_hashed: Key NULL", NULL);
+    CHECK_NONZERO(key_len, "ht_search_hashed: Zero key length", NULL);
+
+    index = find_index(ht, hash_key, key);
+    if (index >= 0) {return ht->table[index].value;}
+
+    DBG_info("ht_search_hashed: Key not found");
+    return NULL;
+}
+
+HTResult ht_insert(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        void *value
+) {
+    CHECK_NULL(ht, "ht_insert: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert: Zero key length", HT_INVALID_ARG);
+
+    return ht_insert_hashed(
+        ht,
+        key,
+        key_len,
+        compute_hash(ht, key, key_len),
+        value
+    );
+}
+
+HTResult ht_insert_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key,
+        void *value
+) {
+    CHECK_NULL(ht, "ht_insert_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_insert_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_insert_hashed: Zero key length", HT_INVALID_ARG);
+
+    if (ht_search_hashed(ht, key, key_len, hash_key)) {
+        return HT_KEY_EXISTS;
+    }
+
+    /* keys sharing the full hash share a home at every size */
+    if (neighbourhood_shared(ht, hash_key)) {return HT_FAILURE;}
+
+    /* grow at most once per insert, the new key moves along with the
+     * entries, and a key that still finds no room leaves the table as it was */
+    if (ht->active + 1 > ht->size * ht->load_factor) {
+        return resize(ht, ht->size << 1, hash_key, (void *)key, value);
+    }
+    if (insert_entry(ht, hash_key, (void *)key, value) == HT_SUCCESS) {
+        return HT_SUCCESS;
+    }
+    return resize(ht, ht->size << 1, hash_key, (void *)key, value);
+}
+
+/**
+ * @brief Removes a key and its associated value from the hash table.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key to remove.
+ * @param key_len Length of the key in bytes.
+ * @return HT_SUCCESS on success,
+ *         HT_INVALID_ARG if inputs are invalid,
+ *         HT_KEY_NOT_FOUND if key isn’t found.
+ */
+HTResult ht_remove(HashTab *ht, const void *key, size_t key_len) {
+    CHECK_NULL(ht, "ht_remove: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove: Zero key length", HT_INVALID_ARG);
+
+    return ht_remove_hashed(ht, key, key_len, compute_hash(ht, key, key_len));
+}
+
+HTResult ht_remove_hashed(
+        HashTab *ht,
+        const void *key,
+        size_t key_len,
+        uint32_t hash_key
+) {
+    CHECK_NULL(ht, "ht_remove_hashed: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(key, "ht_remove_hashed: Key NULL", HT_INVALID_ARG);
+    CHECK_NONZERO(key_len, "ht_remove_hashed: Zero key length", HT_INVALID_ARG);
+
+    return remove_entry(ht, hash_key, key);
+}
+
+void ht_destroy(
+		HashTab *ht
+) {
+    uint32_t i;
+
+    if (ht == NULL) {
+        return;
+    }
+
+    for (i = 0; i < ht->size; i++) {
+        if (ht->table[i].key != NULL) {
+            free_entry(ht, &ht->table[i]);
+        }
+    }
+
+    free(ht->table);
+    ht->table = NULL;
+    ht->hash_func = NULL;
+    ht->cmp_func = NULL;
+    free(ht);
+}
+
+void ht_print(
+    const HashTab *ht,
+    void (*format_key)(void *key, char *buf, size_t buf_size),
+    void (*format_value)(void *value, char *buf, size_t buf_size)
+) {
+    char key_buffer[PRINT_BUFFER_SIZE];
+    char value_buffer[PRINT_BUFFER_SIZE];
+    if (!ht || !format_key || !format_value) return;
+
+    printf("--- HashTab - size[%u] - entries[%u] - loadfct[%.2f] ---\n",
+           ht->size, ht->active, ht->load_factor);
+
+    for (uint32_t i = 0; i < ht->size; i++) {
+        HTentry *entry = &ht->table[i];
+        if (entry->key == NULL) {continue;}
+        format_key(entry->key, key_buffer, PRINT_BUFFER_SIZE);
+        format_value(entry->value, value_buffer, PRINT_BUFFER_SIZE);
+        printf(
+            "Index %u: hash=%u, hop=%08x, key=%s, value=%s\n",
+            i, entry->hash_key, entry->hop_info, key_buffer, value_buffer
+        );
+    }
+}
+
+uint32_t ht_capacity(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_capacity: HashTab NULL", 0);
+    return ht->size;
+}
+
+uint32_t ht_max_psl(
+        const HashTab *ht
+) {
+    CHECK_NULL(ht, "ht_max_psl: HashTab NULL", 0);
+    return ht->max_psl;
+}
+
+HTResult ht_stats(
+        const HashTab *ht,
+        HTStats *out
+) {
+    uint32_t i, psl, mask;
+    uint64_t psl_sum;
+
+    CHECK_NULL(ht, "ht_stats: HashTab NULL", HT_INVALID_ARG);
+    CHECK_NULL(out, "ht_stats: HTStats NULL", HT_INVALID_ARG);
+
+    memset(out, 0, sizeof(*out));
+    out->capacity = ht->size;
+    out->active = ht->active;
+    out->load_factor = (float)ht->active / (float)ht->size;
+
+    mask = ht->size - 1;
+    psl_sum = 0;
+    for (i = 0; i < ht->size; i++) {
+        if (ht->table[i].key == NULL) {continue;}
+        psl = (i - ht->table[i].hash_key) & mask;
+        psl_sum += psl;
+        if (psl > out->max_psl) {out->max_psl = psl;}
+        if (psl >= HT_STATS_PSL_BUCKETS) {psl = HT_STATS_PSL_BUCKETS - 1;}
+        out->psl_histogram[psl]++;
+    }
+    out->avg_psl = ht->active ? (double)psl_sum / ht->active : 0.0;
+    out->bytes_allocated = sizeof(HashTab) + (size_t)ht->size * sizeof(HTentry);
+    STATS_export(ht, out);
+
+    return HT_SUCCESS;
+}
+
+/* --- utility functions ---------------------------------------------------- */
+
+/**
+ * @brief Inserts a key-value pair into the neighbourhood of its home slot.
+ *
+ * The nearest free slot is found by linear probing. While it lies outside
+ * the neighbourhood, an entry between the home slot and the free slot that
+ * may legally live at the free slot is moved there, bringing the free slot
+ * closer.
+ *
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key data.
+ * @param value Pointer to the value data.
+ * @return HT_SUCCESS on success, HT_FAILURE if the neighbourhood is full.
+ */
+static HTResult insert_entry(
+        HashTab *ht,
+        uint32_t hash_key,
+        void *key,
+        void *value
+) {
+    uint32_t home, free_index, dist, limit;
+    HTentry *entry;
+
+    home = probe_func(hash_key, 0, ht->size);
+    limit = ht->size < ADD_RANGE ? ht->size : ADD_RANGE;
+    for (dist = 0; dist < limit; dist++) {
+        if (ht->table[probe_func(home, dist, ht->size)].key == NULL) {break;}
+    }
+    if (dist == limit) {return HT_FAILURE;}
+
+    free_index = probe_func(home, dist, ht->size);
+    while (dist >= HOP_RANGE) {
+        if (!hop_closer(ht, &free_index)) {return HT_FAILURE;}
+        dist = (free_index - home) & (ht->size - 1);
+    }
+
+    entry = &ht->table[free_index];
+    entry->hash_key = hash_key;
+    entry->key = key;
+    entry->value = value;
+    ht->table[home].hop_info |= 1u << dist;
+    if (dist > ht->max_psl) {ht->max_psl = dist;}
+    ht->active++;
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Moves the free slot towards the start of its neighbourhood.
+ *
+ * Looks at the HOP_RANGE - 1 home slots before the free slot, furthest
+ * first, for an entry stored before the free slot, and moves that entry
+ * into the free slot.
+ *
+ * @param ht Pointer to the hash table.
+ * @param free_index In/out index of the free slot.
+ * @return 1 if the free slot moved, 0 if no entry could be moved.
+ */
+static int hop_closer(
+        HashTab *ht,
+        uint32_t *free_index
+) {
+    uint32_t back, home, hop, bit, target, mask;
+    HTentry *src, *dst;
+
+    mask = ht->size - 1;
+    for (back = HOP_RANGE - 1; back > 0; back--) {
+        home = (*free_index - back) & mask;
+        /* only entries stored before the free slot */
+        hop = ht->table[home].hop_info & ((1u << back) - 1);
+        if (hop == 0) {continue;}
+
+        bit = (uint32_t)__builtin_ctz(hop);
+        target = (home + bit) & mask;
+        src = &ht->table[target];
+        dst = &ht->table[*free_index];
+        dst->hash_key = src->hash_key;
+        dst->key = src->key;
+        dst->value = src->value;
+        src->hash_key = 0;
+        src->key = NULL;
+        src->value = NULL;
+        ht->table[home].hop_info ^= (1u << bit) | (1u << back);
+        if (back > ht->max_psl) {ht->max_psl = back;}
+        *free_index = target;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Attempts to find and remove an entry with the given hash key and key.
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @param key Pointer to the key to remove.
+ * @return HT_SUCCESS if removed, HT_KEY_NOT_FOUND if not found.
+ */
+static HTResult remove_entry(
+        HashTab *ht,
+        uint32_t hash_key,
+        const void *key
+) {
+    uint32_t home;
+    int32_t index;
+
+    index = find_index(ht, hash_key, key);
+    if (index < 0) {return HT_KEY_NOT_FOUND;}
+
+    home = probe_func(hash_key, 0, ht->size);
+    ht->table[home].hop_info &= ~(1u << (((uint32_t)index - home) & (ht->size - 1)));
+    free_entry(ht, &ht->table[index]);
+    remove_table_update(ht);
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Updates the table state after removal, including resizing if needed.
+ * @param ht Pointer to the hash table.
+ */
+static void remove_table_update(
+        HashTab *ht
+) {
+    ht->active--;
+    if (ht->active < (float)ht->size * ht->min_load_factor && ht->size > 2) {
+        resize(ht, ht->size / 2, 0, NULL, NULL);  /* Downsize if below min load factor */
+    }
+}
+
+/**
+ * @brief Checks whether a key's neighbourhood is full of its own hash.
+ *
+ * Entries with the same full hash keep sharing one home slot after any
+ * number of doublings, so growing cannot make room for another one.
+ *
+ * @param ht Pointer to the hash table.
+ * @param hash_key Precomputed hash value of the key.
+ * @return 1 if every neighbourhood slot holds hash_key, 0 otherwise.
+ */
+static int neighbourhood_shared(
+        HashTab *ht,
+        uint32_t hash_key
+) {
+    uint32_t home, dist;
+
+    if (ht->size < HOP_RANGE) {return 0;}
+    home = probe_func(hash_key, 0, ht->size);
+    if (ht->table[home].hop_info != UINT32_MAX) {return 0;}
+    for (dist = 0; dist < HOP_RANGE; dist++) {
+        if (ht->table[probe_func(home, dist, ht->size)].hash_key != hash_key) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Resizes the hash table and optionally inserts one more entry.
+ *
+ * When an entry finds no room in the new table the old table is kept
+ * unchanged, so a failed insert never leaves the table grown.
+ *
+ * @param ht Pointer to the hash table.
+ * @param new_size New size of the table (power of 2).
+ * @param hash_key Precomputed hash value of the pending key.
+ * @param key Pending key to insert after the entries, NULL for none.
+ * @param value Value of the pending key.
+ * @return HT_SUCCESS on success, HT_MEM_ERROR or HT_FAILURE on failure.
+ */
+static HTResult resize(
+        HashTab *ht,
+        uint32_t new_size,
+        uint32_t hash_key,
+        void *key,
+        void *value
+) {
+    HTentry *old_table;
+    uint32_t old_size, old_active, old_max_psl, i;
+    HTResult result;
+    STATS_timer(start);
+
+    result = validate_size(ht->size, new_size);
+    if (result != HT_SUCCESS) {return result;}
+
+    old_table = ht->table;
+    old_size = ht->size;
+    old_active = ht->active;
+    old_max_psl = ht->max_psl;
+
+    ht->table = (HTentry *)calloc(new_size, sizeof(HTentry));
+    if (ht->table == NULL) {
+        LOG_ERROR("%s", "Resize allocation failed");
+        ht->table = old_table;
+        return HT_MEM_ERROR;
+    }
+    ht->size = new_size;
+    ht->active = 0;
+    ht->max_psl = 0;
+
+    result = HT_SUCCESS;
+    for (i = 0; i < old_size && result == HT_SUCCESS; i++) {
+        if (old_table[i].key == NULL) {continue;}
+        result = insert_entry(
+            ht, old_table[i].hash_key, old_table[i].key, old_table[i].value
+        );
+    }
+    if (result == HT_SUCCESS && key) {
+        result = insert_entry(ht, hash_key, key, value);
+    }
+    if (result == HT_SUCCESS) {
+        free(old_table);
+        STATS_resize(ht, start);
+        return HT_SUCCESS;
+    }
+
+    /* the old entries are untouched, restore the old table */
+    free(ht->table);
+    ht->table = old_table;
+    ht->size = old_size;
+    ht->active = old_active;
+    ht->max_psl = old_max_psl;
+    return HT_FAILURE;
+}
+
+/**
+ * @brief Frees the memory associated with an entry and marks it empty.
+ * @param ht Pointer to the hash table.
+ * @param entry Pointer to the entry to free.
+ */
+static void free_entry(
+        HashTab *ht,
+        HTentry *entry
+) {
+    if (ht->free_key) {ht->free_key(entry->key);}
+    if (ht->free_val) {ht->free_val(entry->value);}
+    entry->hash_key = 0;
+    entry->key = NULL;
+    entry->value = NULL;
+}
+
+/* Helper function to find the slot of a key via its hop bitmap, or -1 */
+static inline int32_t find_index(
+        const HashTab *ht,
+        uint32_t hash_key,
+        const void *key
+) {
+    uint32_t home, hop, index;
+    const HTentry *entry;
+
+    home = probe_func(hash_key, 0, ht->size);
+    for (hop = ht->table[home].hop_info; hop != 0; hop &= hop - 1) {
+        index = probe_func(home, (uint32_t)__builtin_ctz(hop), ht->size);
+        entry = &ht->table[index];
+        if (entry->hash_key == hash_key && ht->cmp_func(entry->key, key) == 0) {
+            return (int32_t)index;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Computes the slot index using linear probing.
+ * @param k Hash key value.
+ * @param i Probe iteration number.
+ * @param m Table size (must be a power of 2).
+ * @return Index into the hash table.
+ */
+static inline uint32_t probe_func(
+    uint32_t k,
+    uint32_t i,
+    uint32_t m
+) {
+    return (k + i) & (m - 1);
+}
+
+/* --- default functions ---------------------------------------------------- */
+
+/**
+ * @brief Hashes a key with the keyed hash when one is configured.
+ * @param ht Pointer to the hash table.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static inline uint32_t compute_hash(
+    const HashTab *ht,
+    const void *key,
+    size_t len
+) {
+    if (ht->seeded_hash_func) {
+        return ht->seeded_hash_func(key, len, ht->seed);
+    }
+    return ht->hash_func(key, len);
+}
+
+/**
+ * @brief Computes a default hash value for a key using the FNV-1a algorithm.
+ * @param key Pointer to the key data.
+ * @param len Length of the key in bytes.
+ * @return 32-bit hash value.
+ */
+static uint32_t default_hash_func(
+    const void *key,
+    size_t len
+) {
+    const unsigned char *bytes_ptr = (const unsigned char *)key;
+    unsigned int hash = 2166136261u; // FNV offset basis
+    unsigned int fnv_prime = 16777619u; // FNV prime
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes_ptr[i];       // XOR with the byte
+        hash *= fnv_prime;          // Multiply by FNV prime
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Compares two integer keys for equality or ordering.
+ * @param a Pointer to the first key.
+ * @param b Pointer to the second key.
+ * @return Negative if a < b, 0 if a == b, positive if a > b.
+ */
+static int default_cmp_func(
+    const void *a,
+    const void *b
+) {
+    int int_a = *(const int *)a;
+    int int_b = *(const int *)b;
+    return (int_a > int_b) - (int_a < int_b);
+}
+
+/* --- validadation functions ---------------------------------------------- */
+
+/**
+ * @brief Validates load factor values for correctness.
+ * @param load_factor Maximum load factor.
+ * @param min_load_factor Minimum load factor.
+ * @return HT_SUCCESS if valid, HT_INVALID_ARG if invalid.
+ */
+static inline HTResult validate_load_factors(
+    float load_factor,
+    float min_load_factor
+) {
+    if (load_factor <= 0 || load_factor > 1) {
+        LOG_ERROR("Invalid load_factor: %.2f", load_factor);
+        return HT_INVALID_ARG;
+    }
+    if (min_load_factor < 0 || min_load_factor >= load_factor) {
+        LOG_ERROR("Invalid min_load_factor: %.2f", min_load_factor);
+        return HT_INVALID_ARG;
+    }
+    return HT_SUCCESS;
+}
+
+/**
+ * @brief Validates a new size against constraints.
+ * @param size Current size of the table.
+ * @param new_size Proposed new size.
+ * @return HT_SUCCESS if valid, HT_FAILURE if invalid.
+ */
+static inline HTResult validate_size(
+    uint32_t size,
+    uint32_t new_size
+) {
+    (void)size;
+    if (new_size == 0 || new_size > UINT32_MAX / 2) {
+        LOG_ERROR("Invalid size: %u", new_size);
+        return HT_FAILURE;
+    }
+    return HT_SUCCESS;
+}
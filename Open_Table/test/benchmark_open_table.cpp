@@ -1,12 +1,23 @@
 #include <benchmark/benchmark.h>
 extern "C" {
     #include "open_table.h"
+    #include "ht_hash.h"
 }
 #include <cstdlib>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
+// The table stores key/value pointers, so keys must outlive the table
+static std::vector<int> make_keys(int size) {
+    std::vector<int> keys(size);
+    for (int i = 0; i < size; i++) {
+        keys[i] = rand();
+    }
+    return keys;
+}
+
 // Benchmark the insertion of keys into the hash table
 static void BM_OpenTableInsert(benchmark::State& state) {
     int size = (int)state.range(0);
@@ -14,38 +25,37 @@ static void BM_OpenTableInsert(benchmark::State& state) {
 
     HTConfig config = HT_DEFAULT_CONFIG;
     config.load_factor = load_factor;  // Override default load factor
+    std::vector<int> keys = make_keys(size);
 
     for (auto _ : state) {
         HashTab* ht = ht_create(&config);
         for (int i = 0; i < size; i++) {
-            int key = rand();
-            int value = i;
-            ht_insert(ht, &key, sizeof(int), &value);
+            ht_insert(ht, &keys[i], sizeof(int), &keys[i]);
         }
         ht_destroy(ht);
     }
 }
 
-// Benchmark searching in the hash table
+// Benchmark searching in the hash table, range(2) != 0 declares the fixed
+// key length so ht_create picks the integer hash
 static void BM_OpenTableSearch(benchmark::State& state) {
     int size = (int)state.range(0);
     float load_factor = state.range(1) / 100.0f;
 
     HTConfig config = HT_DEFAULT_CONFIG;
     config.load_factor = load_factor;
+    config.key_len = state.range(2) ? sizeof(int) : 0;
 
     // Pre-populate the table
+    std::vector<int> keys = make_keys(size);
     HashTab* ht = ht_create(&config);
     for (int i = 0; i < size; i++) {
-        int key = rand();
-        int value = i;
-        ht_insert(ht, &key, sizeof(int), &value);
+        ht_insert(ht, &keys[i], sizeof(int), &keys[i]);
     }
 
     for (auto _ : state) {
         for (int i = 0; i < size; i++) {
-            int key = i;
-            benchmark::DoNotOptimize(ht_search(ht, &key, sizeof(int)));
+            benchmark::DoNotOptimize(ht_search(ht, &keys[i], sizeof(int)));
         }
     }
     ht_destroy(ht);
@@ -59,25 +69,147 @@ static void BM_OpenTableRemove(benchmark::State& state) {
     HTConfig config = HT_DEFAULT_CONFIG;
     config.load_factor = load_factor;
 
+    std::vector<int> keys = make_keys(size);
+
     for (auto _ : state) {
         HashTab* ht = ht_create(&config);
         for (int i = 0; i < size; i++) {
-            int key = rand();
-            int value = i;
-            ht_insert(ht, &key, sizeof(int), &value);
+            ht_insert(ht, &keys[i], sizeof(int), &keys[i]);
+        }
+        for (int i = 0; i < size; i++) {
+            ht_remove(ht, &keys[i], sizeof(int));
+        }
+        ht_destroy(ht);
+    }
+}
+
+// Benchmark looking the same long key up in several tables, hashing it
+// once per table (range(1) == 0) or once per lookup round (range(1) == 1)
+static const size_t LONG_KEY_LEN = 100;
+static const int NUM_TABLES = 3;
+
+static int compare_long_keys(const void *a, const void *b) {
+    return memcmp(a, b, LONG_KEY_LEN);
+}
+
+static void BM_OpenTableSearchTables(benchmark::State& state) {
+    int size = (int)state.range(0);
+    bool prehashed = state.range(1) != 0;
+
+    HTConfig config = HT_DEFAULT_CONFIG;
+    config.cmp_func = compare_long_keys;
+
+    std::vector<char> keys((size_t)size * LONG_KEY_LEN);
+    for (size_t i = 0; i < keys.size(); i++) {
+        keys[i] = (char)rand();
+    }
+    HashTab *tables[NUM_TABLES];
+    for (int t = 0; t < NUM_TABLES; t++) {
+        tables[t] = ht_create(&config);
+        // each table holds a different subset of the keys
+        for (int i = t; i < size; i += t + 1) {
+            ht_insert(tables[t], &keys[i * LONG_KEY_LEN], LONG_KEY_LEN, &keys[i * LONG_KEY_LEN]);
         }
+    }
+
+    for (auto _ : state) {
         for (int i = 0; i < size; i++) {
-            int key = i;
-            ht_remove(ht, &key, sizeof(int));
+            const void *key = &keys[i * LONG_KEY_LEN];
+            if (prehashed) {
+                uint32_t hash = ht_hash(tables[0], key, LONG_KEY_LEN);
+                for (int t = 0; t < NUM_TABLES; t++) {
+                    benchmark::DoNotOptimize(
+                        ht_search_hashed(tables[t], key, LONG_KEY_LEN, hash));
+                }
+            } else {
+                for (int t = 0; t < NUM_TABLES; t++) {
+                    benchmark::DoNotOptimize(
+                        ht_search(tables[t], key, LONG_KEY_LEN));
+                }
+            }
+        }
+    }
+    for (int t = 0; t < NUM_TABLES; t++) {
+        ht_destroy(tables[t]);
+    }
+}
+
+// Benchmark inserting keys built to share one home slot under the default
+// unseeded FNV-1a. range(0): 0 default hash, 1 fnv1a_seeded, 2 siphash13,
+// 3 default hash without reseeding on long PSLs; range(1): 0 random keys,
+// 1 adversarial keys
+static const size_t ATTACK_KEY_LEN = 8;
+static const int ATTACK_KEYS = 2000;
+static const uint32_t ATTACK_MASK = 0xFFF;  // home slot bits at 4096 slots
+
+static uint32_t fnv1a_default(const unsigned char *p, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int compare_attack_keys(const void *a, const void *b) {
+    return memcmp(a, b, ATTACK_KEY_LEN);
+}
+
+// bytes 0-3 number the key, bytes 4-7 are searched until the low hash
+// bits match, about 4096 tries per key
+static const std::vector<unsigned char>& attack_keys(bool adversarial) {
+    static std::vector<unsigned char> keys[2];
+    std::vector<unsigned char>& out = keys[adversarial];
+    if (!out.empty()) {return out;}
+
+    out.resize((size_t)ATTACK_KEYS * ATTACK_KEY_LEN);
+    for (int i = 0; i < ATTACK_KEYS; i++) {
+        unsigned char *key = &out[(size_t)i * ATTACK_KEY_LEN];
+        uint32_t id = (uint32_t)i, salt = adversarial ? 0 : (uint32_t)rand();
+        memcpy(key, &id, sizeof(id));
+        do {
+            memcpy(key + 4, &salt, sizeof(salt));
+            salt++;
+        } while (adversarial && (fnv1a_default(key, ATTACK_KEY_LEN) & ATTACK_MASK) != 0);
+    }
+    return out;
+}
+
+static void BM_OpenTableInsertAttack(benchmark::State& state) {
+    static const HTSeededHashFunc seeded[] = {NULL, fnv1a_seeded_hash, siphash13_hash, NULL};
+    const std::vector<unsigned char>& keys = attack_keys(state.range(1) != 0);
+
+    HTConfig config = HT_DEFAULT_CONFIG;
+    config.cmp_func = compare_attack_keys;
+    config.seeded_hash_func = seeded[state.range(0)];
+    if (state.range(0) == 3) {
+        config.reseed_psl_factor = 0;
+    }
+
+    for (auto _ : state) {
+        HashTab* ht = ht_create(&config);
+        for (int i = 0; i < ATTACK_KEYS; i++) {
+            const void *key = &keys[(size_t)i * ATTACK_KEY_LEN];
+            ht_insert(ht, key, ATTACK_KEY_LEN, (void *)key);
         }
         ht_destroy(ht);
     }
 }
 
 // Benchmark Registration
+static std::vector<int> load_factor_sweep() {
+    std::vector<int> load_factors = {75, 80, 90};  // 0.75, 0.80, 0.90 as percentages
+#ifdef HT_CAP_OVERLOAD
+    // Chained tables keep working past one entry per slot
+    load_factors.push_back(150);
+    load_factors.push_back(200);
+#endif
+    return load_factors;
+}
+
 static void RegisterInsertBenchmarks() {
     std::vector<int> sizes = {1000, 10000, 100000};
-    std::vector<int> load_factors = {75, 80, 90};  // 0.75, 0.80, 0.90 as percentages
+    std::vector<int> load_factors = load_factor_sweep();
 
     for (int sz : sizes) {
         for (int lf : load_factors) {
@@ -90,20 +222,23 @@ static void RegisterInsertBenchmarks() {
 
 static void RegisterSearchBenchmarks() {
     std::vector<int> sizes = {1000, 10000, 100000, 1000000};
-    std::vector<int> load_factors = {75, 80, 90};
+    std::vector<int> load_factors = load_factor_sweep();
 
     for (int sz : sizes) {
         for (int lf : load_factors) {
             std::string name = "Search/" + std::to_string(sz) + "/LF" + std::to_string(lf);
             benchmark::RegisterBenchmark(name.c_str(), BM_OpenTableSearch)
-                ->Args({sz, lf});
+                ->Args({sz, lf, 0});
         }
+        std::string name = "SearchIntHash/" + std::to_string(sz) + "/LF75";
+        benchmark::RegisterBenchmark(name.c_str(), BM_OpenTableSearch)
+            ->Args({sz, 75, 1});
     }
 }
 
 static void RegisterRemoveBenchmarks() {
     std::vector<int> sizes = {1000, 10000, 100000};
-    std::vector<int> load_factors = {75, 80, 90};
+    std::vector<int> load_factors = load_factor_sweep();
 
     for (int sz : sizes) {
         for (int lf : load_factors) {
@@ -114,11 +249,39 @@ static void RegisterRemoveBenchmarks() {
     }
 }
 
+static void RegisterSearchTablesBenchmarks() {
+    std::vector<int> sizes = {1000, 100000};
+
+    for (int sz : sizes) {
+        for (int prehashed = 0; prehashed <= 1; prehashed++) {
+            std::string name = "SearchTables/" + std::to_string(sz) +
+                (prehashed ? "/Prehashed" : "/Rehashed");
+            benchmark::RegisterBenchmark(name.c_str(), BM_OpenTableSearchTables)
+                ->Args({sz, prehashed});
+        }
+    }
+}
+
+static void RegisterAttackBenchmarks() {
+    const char *hashes[] = {"FNV1a", "FNV1aSeeded", "SipHash13", "FNV1aNoReseed"};
+
+    for (int h = 0; h < 4; h++) {
+        for (int adversarial = 0; adversarial <= 1; adversarial++) {
+            std::string name = std::string("InsertAttack/") + hashes[h] +
+                (adversarial ? "/Adversarial" : "/Random");
+            benchmark::RegisterBenchmark(name.c_str(), BM_OpenTableInsertAttack)
+                ->Args({h, adversarial});
+        }
+    }
+}
+
 // Custom main to register benchmarks
 int main(int argc, char** argv) {
     RegisterInsertBenchmarks();
     RegisterSearchBenchmarks();
     RegisterRemoveBenchmarks();
+    RegisterSearchTablesBenchmarks();
+    RegisterAttackBenchmarks();
 
     ::benchmark::Initialize(&argc, argv);
     ::benchmark::RunSpecifiedBenchmarks();
@@ -11,6 +11,7 @@
 #include <string.h>
 #include "unity.h"
 #include "open_table.h"
+#include "ht_hash.h"
 
 /* Global pointer to a hash table used by all tests */
 static HashTab *ht = NULL;
@@ -461,7 +462,13 @@ void test_create_invalid_load_factors(void) {
 
     config.load_factor = 1.5f;  // Invalid: > 1
     ht_invalid = ht_create(&config);
+#ifdef HT_CAP_OVERLOAD
+    /* Chains hold any number of entries per slot */
+    TEST_ASSERT_NOT_NULL(ht_invalid);
+    ht_destroy(ht_invalid);
+#else
     TEST_ASSERT_NULL(ht_invalid);
+#endif
 
     config.load_factor = 0.75f;
     config.min_load_factor = 0.8f;  // Invalid: min_load_factor >= load_factor
@@ -541,6 +548,43 @@ void test_insert_with_constant_hash(void) {
     ht_destroy(ht_collide);
 }
 
+/**
+ * @brief Test that colliding keys grow the table at most once per insert.
+ *
+ * Variants with bounded placement may reject some of the keys, but a
+ * rejected insert must leave the capacity as it was.
+ */
+void test_constant_hash_growth_bounded(void) {
+    HTConfig config = {
+        .load_factor = 0.75f,
+        .min_load_factor = 0.25f,
+        .hash_func = constant_hash_func,
+        .cmp_func = compare_int_keys,
+        .free_key = free,
+        .free_val = free
+    };
+    HashTab *ht_collide = ht_create(&config);
+    TEST_ASSERT_NOT_NULL(ht_collide);
+
+    for (int i = 0; i < 40; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i;
+        uint32_t before = ht_capacity(ht_collide);
+        HTResult result = ht_insert(ht_collide, key, sizeof(int), value);
+        if (result == HT_SUCCESS) {
+            TEST_ASSERT_TRUE(ht_capacity(ht_collide) <= 2 * before);
+        } else {
+            TEST_ASSERT_EQUAL_UINT32(before, ht_capacity(ht_collide));
+            free(key);
+            free(value);
+        }
+    }
+
+    ht_destroy(ht_collide);
+}
+
 /**
  * @brief Test insertion and search with string keys.
  */
@@ -691,10 +735,14 @@ void test_extreme_load_factors(void) {
         *value = i * 10;
         HTResult result = ht_insert(ht_extreme, key, sizeof(int), value);
         TEST_ASSERT_EQUAL_INT(HT_SUCCESS, result);
-        if (i > 0) {  // After first insertion, expect resize
-            TEST_ASSERT_TRUE(ht_capacity(ht_extreme) > prev_size);
-            prev_size = ht_capacity(ht_extreme);
+        /* Bucketed tables start with several slots, so expect a resize
+         * whenever the insert exceeded the load factor, not on every one */
+        uint32_t size = ht_capacity(ht_extreme);
+        TEST_ASSERT_TRUE(size >= prev_size);
+        if (i > 0 && (float)(i + 1) > prev_size * config.load_factor) {
+            TEST_ASSERT_TRUE(size > prev_size);
         }
+        prev_size = size;
     }
 
     ht_destroy(ht_extreme);
@@ -722,6 +770,301 @@ void test_very_large_insertions(void) {
     }
 }
 
+/**
+ * @brief Test that the maximum PSL tracks colliding inserts and bounds searches.
+ */
+void test_max_psl_tracking(void) {
+    HTConfig config = {
+        .load_factor = 0.75f,
+        .min_load_factor = 0.25f,
+        .hash_func = constant_hash_func,
+        .cmp_func = compare_int_keys,
+        .free_key = free,
+        .free_val = free
+    };
+    HashTab *ht_collide = ht_create(&config);
+    TEST_ASSERT_NOT_NULL(ht_collide);
+    TEST_ASSERT_EQUAL_UINT32(0, ht_max_psl(ht_collide));
+
+    for (int i = 0; i < 6; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i;
+        HTResult result = ht_insert(ht_collide, key, sizeof(int), value);
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, result);
+    }
+#ifdef HT_CAP_TWO_CHOICE
+    /* Colliding keys fill their two buckets, the PSL only names which one */
+    TEST_ASSERT_EQUAL_UINT32(1, ht_max_psl(ht_collide));
+#else
+    /* All keys share one home slot, so the last one sits 5 slots away */
+    TEST_ASSERT_EQUAL_UINT32(5, ht_max_psl(ht_collide));
+#endif
+
+    int missing = 6;
+    TEST_ASSERT_NULL(ht_search(ht_collide, &missing, sizeof(int)));
+    for (int i = 0; i < 6; i++) {
+        int temp_key = i;
+        void *fetched_val = ht_search(ht_collide, &temp_key, sizeof(int));
+        TEST_ASSERT_NOT_NULL(fetched_val);
+        TEST_ASSERT_EQUAL_INT(i, *(int *)fetched_val);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ht_max_psl(NULL));
+
+    ht_destroy(ht_collide);
+}
+
+/**
+ * @brief Test that ht_stats reports a snapshot consistent with the table.
+ */
+void test_stats_snapshot(void) {
+    HTStats stats;
+    const int num_keys = 100;
+
+    for (int i = 0; i < num_keys; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i;
+        HTResult result = ht_insert(ht, key, sizeof(int), value);
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, result);
+    }
+
+    TEST_ASSERT_EQUAL_INT(HT_SUCCESS, ht_stats(ht, &stats));
+    TEST_ASSERT_EQUAL_UINT32(ht_capacity(ht), stats.capacity);
+    TEST_ASSERT_EQUAL_UINT32(num_keys, stats.active);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, (float)num_keys / stats.capacity, stats.load_factor);
+    TEST_ASSERT_TRUE(stats.max_psl <= ht_max_psl(ht));
+    TEST_ASSERT_TRUE(stats.avg_psl <= stats.max_psl);
+    TEST_ASSERT_TRUE(stats.bytes_allocated > 0);
+
+    uint32_t histogram_total = 0;
+    for (int i = 0; i < HT_STATS_PSL_BUCKETS; i++) {
+        histogram_total += stats.psl_histogram[i];
+    }
+    TEST_ASSERT_EQUAL_UINT32(num_keys, histogram_total);
+#ifdef HT_STATS
+    TEST_ASSERT_TRUE(stats.resize_count > 0);
+#else
+    TEST_ASSERT_EQUAL_UINT64(0, stats.resize_count);
+#endif
+
+    TEST_ASSERT_EQUAL_INT(HT_INVALID_ARG, ht_stats(NULL, &stats));
+    TEST_ASSERT_EQUAL_INT(HT_INVALID_ARG, ht_stats(ht, NULL));
+}
+
+/**
+ * @brief Test that one precomputed hash serves lookups in several tables.
+ */
+void test_prehashed_operations(void) {
+    HTConfig config = {
+        .load_factor = 0.75f,
+        .min_load_factor = 0.25f,
+        .hash_func = NULL,
+        .cmp_func = compare_int_keys,
+        .free_key = NULL,           /* keys and values are owned by ht */
+        .free_val = NULL
+    };
+    HashTab *other = ht_create(&config);
+    TEST_ASSERT_NOT_NULL(other);
+
+    for (int i = 0; i < 100; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i * 2;
+        uint32_t hash = ht_hash(ht, key, sizeof(int));
+        TEST_ASSERT_EQUAL_UINT32(hash, ht_hash(other, key, sizeof(int)));
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS,
+                ht_insert_hashed(ht, key, sizeof(int), hash, value));
+        if (i % 2 == 0) {
+            TEST_ASSERT_EQUAL_INT(HT_SUCCESS,
+                    ht_insert_hashed(other, key, sizeof(int), hash, value));
+        }
+    }
+
+    /* one hash serves lookups in both tables, plain lookups still agree */
+    for (int i = 0; i < 100; i++) {
+        int temp_key = i;
+        uint32_t hash = ht_hash(ht, &temp_key, sizeof(int));
+        void *fetched = ht_search_hashed(ht, &temp_key, sizeof(int), hash);
+        TEST_ASSERT_NOT_NULL(fetched);
+        TEST_ASSERT_EQUAL_PTR(fetched, ht_search(ht, &temp_key, sizeof(int)));
+        if (i % 2 == 0) {
+            TEST_ASSERT_EQUAL_PTR(fetched,
+                    ht_search_hashed(other, &temp_key, sizeof(int), hash));
+        } else {
+            TEST_ASSERT_NULL(ht_search_hashed(other, &temp_key, sizeof(int), hash));
+        }
+    }
+
+    int temp_key = 0;
+    uint32_t hash = ht_hash(other, &temp_key, sizeof(int));
+    TEST_ASSERT_EQUAL_INT(HT_SUCCESS,
+            ht_remove_hashed(other, &temp_key, sizeof(int), hash));
+    TEST_ASSERT_EQUAL_INT(HT_KEY_NOT_FOUND,
+            ht_remove_hashed(other, &temp_key, sizeof(int), hash));
+    TEST_ASSERT_NOT_NULL(ht_search_hashed(ht, &temp_key, sizeof(int), hash));
+
+    ht_destroy(other);
+}
+
+/**
+ * @brief Test that a fixed key length selects the integer hash.
+ */
+void test_integer_key_hash_selection(void) {
+    HTConfig config = {
+        .load_factor = 0.75f,
+        .min_load_factor = 0.25f,
+        .hash_func = NULL,
+        .key_len = sizeof(int32_t),
+        .cmp_func = compare_int_keys,
+        .free_key = free,
+        .free_val = free
+    };
+    HashTab *ht_int = ht_create(&config);
+    TEST_ASSERT_NOT_NULL(ht_int);
+
+    for (int i = 0; i < 1000; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i * 3;
+        TEST_ASSERT_EQUAL_UINT32(int32_hash(key, sizeof(int)),
+                                 ht_hash(ht_int, key, sizeof(int)));
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, ht_insert(ht_int, key, sizeof(int), value));
+    }
+    for (int i = 0; i < 1000; i++) {
+        int temp_key = i;
+        void *fetched = ht_search(ht_int, &temp_key, sizeof(int));
+        TEST_ASSERT_NOT_NULL(fetched);
+        TEST_ASSERT_EQUAL_INT(i * 3, *(int *)fetched);
+    }
+    ht_destroy(ht_int);
+
+    TEST_ASSERT_TRUE(ht_hash_for_key_len(8, NULL) == int64_hash);
+    TEST_ASSERT_TRUE(ht_hash_for_key_len(16, NULL) == NULL);
+
+    /* an explicit hash_func always wins over the key length */
+    config.hash_func = constant_hash_func;
+    ht_int = ht_create(&config);
+    int probe = 7;
+    TEST_ASSERT_EQUAL_UINT32(constant_hash_func(&probe, sizeof(int)),
+                             ht_hash(ht_int, &probe, sizeof(int)));
+    ht_destroy(ht_int);
+}
+
+/**
+ * @brief Test random per-table seeds and reproducible fixed seeds.
+ */
+void test_seeded_hash(void) {
+    HTConfig config = {
+        .load_factor = 0.75f,
+        .min_load_factor = 0.25f,
+        .seeded_hash_func = siphash13_hash,
+        .seed = 0,                  /* drawn per table */
+        .cmp_func = compare_int_keys,
+        .free_key = free,
+        .free_val = free
+    };
+    HashTab *first = ht_create(&config);
+    HashTab *second = ht_create(&config);
+    int probe = 42;
+
+    /* independent random seeds, the same key lands on different hashes */
+    TEST_ASSERT_NOT_EQUAL(ht_hash(first, &probe, sizeof(int)),
+                          ht_hash(second, &probe, sizeof(int)));
+    ht_destroy(second);
+
+    for (int i = 0; i < 500; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i + 1;
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, ht_insert(first, key, sizeof(int), value));
+    }
+    for (int i = 0; i < 500; i++) {
+        int temp_key = i;
+        void *fetched = ht_search(first, &temp_key, sizeof(int));
+        TEST_ASSERT_NOT_NULL(fetched);
+        TEST_ASSERT_EQUAL_INT(i + 1, *(int *)fetched);
+    }
+    ht_destroy(first);
+
+    /* a fixed seed is reproducible */
+    config.seeded_hash_func = fnv1a_seeded_hash;
+    config.seed = 12345;
+    first = ht_create(&config);
+    TEST_ASSERT_EQUAL_UINT32(fnv1a_seeded_hash(&probe, sizeof(int), 12345),
+                             ht_hash(first, &probe, sizeof(int)));
+    ht_destroy(first);
+}
+
+/* Reseed callback state, reset by the test that installs count_reseed */
+static int reseed_calls = 0;
+static uint32_t reseed_trigger_psl = 0;
+
+static void count_reseed(const HashTab *table, uint32_t psl) {
+    (void)table;
+    reseed_calls++;
+    reseed_trigger_psl = psl;
+}
+
+/**
+ * @brief Test that a long probe sequence switches the table to a new seed.
+ */
+void test_reseed_on_long_psl(void) {
+#ifndef HT_CAP_RESEED
+    TEST_IGNORE_MESSAGE("table version does not reseed");
+#endif
+    HTConfig config = {
+        .load_factor = 0.75f,
+        .min_load_factor = 0.25f,
+        .hash_func = constant_hash_func,
+        .reseed_psl_factor = DEFAULT_RESEED_PSL_FACTOR,
+        .on_reseed = count_reseed,
+        .cmp_func = compare_int_keys,
+        .free_key = free,
+        .free_val = free
+    };
+    HashTab *ht_bad = ht_create(&config);
+    HTStats stats;
+    int probe = 7;
+
+    TEST_ASSERT_NOT_NULL(ht_bad);
+    reseed_calls = 0;
+    for (int i = 0; i < 1000; i++) {
+        int *key = malloc(sizeof(int));
+        int *value = malloc(sizeof(int));
+        *key = i;
+        *value = i * 5;
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, ht_insert(ht_bad, key, sizeof(int), value));
+    }
+
+    /* every key collides, the table gave up the hash for a seeded one */
+    TEST_ASSERT_TRUE(reseed_calls > 0);
+    TEST_ASSERT_TRUE(reseed_trigger_psl > 0);
+    TEST_ASSERT_NOT_EQUAL(42, ht_hash(ht_bad, &probe, sizeof(int)));
+    TEST_ASSERT_EQUAL_INT(HT_SUCCESS, ht_stats(ht_bad, &stats));
+    TEST_ASSERT_EQUAL_UINT64(reseed_calls, stats.reseed_count);
+    TEST_ASSERT_TRUE(stats.max_psl < 4 * 32);
+    for (int i = 0; i < 1000; i++) {
+        int temp_key = i;
+        void *fetched = ht_search(ht_bad, &temp_key, sizeof(int));
+        TEST_ASSERT_NOT_NULL(fetched);
+        TEST_ASSERT_EQUAL_INT(i * 5, *(int *)fetched);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        TEST_ASSERT_EQUAL_INT(HT_SUCCESS, ht_remove(ht_bad, &i, sizeof(int)));
+    }
+    for (int i = 0; i < 1000; i++) {
+        int temp_key = i;
+        TEST_ASSERT_EQUAL(i % 2 != 0, ht_search(ht_bad, &temp_key, sizeof(int)) != NULL);
+    }
+    ht_destroy(ht_bad);
+}
+
 /* --------------------------------------------------------------------------
    Test Runner
  * -------------------------------------------------------------------------- */
@@ -752,11 +1095,18 @@ int main(void) {
     RUN_TEST(test_create_invalid_load_factors);
     RUN_TEST(test_insert_into_full_table);
     RUN_TEST(test_insert_with_constant_hash);
+    RUN_TEST(test_constant_hash_growth_bounded);
     RUN_TEST(test_insert_and_search_string_keys);
     RUN_TEST(test_multiple_resizes);
     RUN_TEST(test_free_functions_called);
     RUN_TEST(test_extreme_load_factors);
     RUN_TEST(test_very_large_insertions);
+    RUN_TEST(test_max_psl_tracking);
+    RUN_TEST(test_stats_snapshot);
+    RUN_TEST(test_prehashed_operations);
+    RUN_TEST(test_integer_key_hash_selection);
+    RUN_TEST(test_seeded_hash);
+    RUN_TEST(test_reseed_on_long_psl);
 
     return UNITY_END();
 }